@@ -0,0 +1,115 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include "TimeCode.h"
+#include "LaunchData.h"
+#include "AllocProfile.h"
+
+using namespace std;
+
+// Allocation benchmark for the CSV and TimeCode hot paths. Built only by
+// `make allocbench` (with -DALLOC_PROFILE). Prints allocations and bytes per
+// call for each path, counting everything the call allocates (nested
+// ALLOC_SCOPE regions included). With --check (`make alloccheck`) it exits
+// non-zero if any path allocates more per call than its budget, so
+// regressions fail the build.
+
+struct BenchCase {
+    const char* name;     // Function being measured
+    double allocBudget;   // Allowed allocations per call
+    const char* reason;   // Where the budgeted allocations come from
+};
+
+// The sample rows have 8 fields. Two of them (Datum, ~26 bytes, and
+// Detail, up to ~60) are longer than libstdc++'s 15-byte small-string
+// buffer; the rest fit in it.
+static const BenchCase kSplitCsv = {
+    "split_csv", 8,
+    "result vector growing to 8 fields (4), scratch field growing for Datum and Detail (2), "
+    "copying Datum and Detail out (2)"};
+static const BenchCase kParseLine = {
+    "parse_line", 8,
+    "split_csv (8); parse_datum_time reads the Datum in place"};
+static const BenchCase kToString = {
+    "TimeCode::ToString", 1,
+    "\"h:m:s\" fits the small-string buffer; 1 for the stream's buffer on other libraries"};
+static const BenchCase kAddLine = {
+    "LaunchTable::AddLine", 10,
+    "split_csv (8), parse_datum_day's copy of the Datum (1), amortized column growth (1)"};
+
+/**
+ * Reports the per-call allocations of every region since the last Reset,
+ * so a function is charged for the helpers it calls.
+ * @return False if the function is over budget.
+ */
+bool report(const BenchCase &bench, size_t calls) {
+    AllocProfile::Stats stats = AllocProfile::Total();
+    double allocs = static_cast<double>(stats.allocations) / calls;
+    double bytes = static_cast<double>(stats.bytes) / calls;
+    bool ok = allocs <= bench.allocBudget;
+    cout << bench.name << " allocs/call=" << allocs << " bytes/call=" << bytes
+         << " budget=" << bench.allocBudget << endl;
+    if (!ok) {
+        cout << "  OVER BUDGET, expected at most: " << bench.reason << endl;
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+
+    // Sample rows from the data set
+    vector<string> lines;
+    ifstream file("Space_Corrected_Short.csv");
+    string line;
+    getline(file, line);  // Skip header row
+    while (getline(file, line)) {
+        lines.push_back(line);
+    }
+    if (lines.empty()) {
+        cout << "No sample rows found." << endl;
+        return 1;
+    }
+
+    const size_t rounds = 1000;
+    const size_t calls = rounds * lines.size();
+    bool ok = true;
+    size_t sink = 0;  // Keeps results live
+
+    AllocProfile::Reset();
+    for (size_t r = 0; r < rounds; r++) {
+        for (const string& l : lines) {
+            sink += split_csv(l).size();
+        }
+    }
+    ok &= report(kSplitCsv, calls);
+
+    AllocProfile::Reset();
+    for (size_t r = 0; r < rounds; r++) {
+        for (const string& l : lines) {
+            sink += parse_line(l).GetTimeCodeAsSeconds();
+        }
+    }
+    ok &= report(kParseLine, calls);
+
+    AllocProfile::Reset();
+    for (size_t r = 0; r < calls; r++) {
+        sink += TimeCode(0, 0, r).ToString().size();
+    }
+    ok &= report(kToString, calls);
+
+    AllocProfile::Reset();
+    LaunchTable table;
+    for (size_t r = 0; r < rounds; r++) {
+        for (const string& l : lines) {
+            sink += table.AddLine(l);
+        }
+    }
+    ok &= report(kAddLine, calls);
+
+    cout << "sink=" << sink << endl;
+    return check && !ok ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+#include "AllocProfile.h"
+
+#ifdef ALLOC_PROFILE
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// Nothing in here may allocate through operator new, or it would recurse.
+
+namespace {
+    const int kMaxRegions = 64;
+
+    struct Counters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> liveBytes{0};
+        std::atomic<uint64_t> peakLiveBytes{0};
+    };
+
+    // Region 0 is "(untagged)"
+    const char* names[kMaxRegions] = {"(untagged)"};
+    Counters counters[kMaxRegions];
+    Counters total;
+    std::atomic<int> regionCount{1};
+    std::mutex registerLock;
+
+    thread_local int currentRegion = 0;
+
+    // Stored in front of every block so delete knows its size and region.
+    // 16 bytes keeps the caller's pointer aligned like malloc's.
+    struct alignas(16) Header {
+        uint64_t size;
+        uint64_t region;
+    };
+
+    void raise_peak(std::atomic<uint64_t>& peak, uint64_t live) {
+        uint64_t seen = peak.load(std::memory_order_relaxed);
+        while (live > seen && !peak.compare_exchange_weak(seen, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void count_alloc(Counters& c, uint64_t size) {
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+        c.bytes.fetch_add(size, std::memory_order_relaxed);
+        raise_peak(c.peakLiveBytes, c.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    }
+
+    void count_free(Counters& c, uint64_t size) {
+        c.frees.fetch_add(1, std::memory_order_relaxed);
+        c.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void* profiled_alloc(std::size_t size) {
+        Header* header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+        if (header == nullptr) {
+            return nullptr;
+        }
+        header->size = size;
+        header->region = static_cast<uint64_t>(currentRegion);
+        count_alloc(counters[currentRegion], size);
+        count_alloc(total, size);
+        return header + 1;
+    }
+
+    void profiled_free(void* ptr) {
+        if (ptr == nullptr) {
+            return;
+        }
+        Header* header = static_cast<Header*>(ptr) - 1;
+        count_free(counters[header->region], header->size);
+        count_free(total, header->size);
+        std::free(header);
+    }
+
+    AllocProfile::Stats load(const Counters& c) {
+        AllocProfile::Stats stats;
+        stats.allocations = c.allocations.load();
+        stats.frees = c.frees.load();
+        stats.bytes = c.bytes.load();
+        stats.liveBytes = c.liveBytes.load();
+        stats.peakLiveBytes = c.peakLiveBytes.load();
+        return stats;
+    }
+
+    void reset(Counters& c) {
+        c.allocations = 0;
+        c.frees = 0;
+        c.bytes = 0;
+        c.peakLiveBytes = c.liveBytes.load();
+    }
+
+    // Prints the summary once the program exits
+    struct SummaryAtExit {
+        ~SummaryAtExit() { AllocProfile::PrintSummary(); }
+    } summaryAtExit;
+}
+
+int AllocProfile::Region(const char* name) {
+    std::lock_guard<std::mutex> lock(registerLock);
+    int count = regionCount.load();
+    for (int i = 0; i < count; i++) {
+        if (std::strcmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+    if (count == kMaxRegions) {
+        return 0;  // Out of slots; count it as untagged
+    }
+    names[count] = name;
+    regionCount.store(count + 1);  // Publish only after the name is set
+    return count;
+}
+
+bool AllocProfile::Get(const char* name, Stats& stats) {
+    int count = regionCount.load();
+    for (int i = 0; i < count; i++) {
+        if (std::strcmp(names[i], name) == 0) {
+            stats = load(counters[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+AllocProfile::Stats AllocProfile::Total() {
+    return load(total);
+}
+
+void AllocProfile::Reset() {
+    int count = regionCount.load();
+    for (int i = 0; i < count; i++) {
+        reset(counters[i]);
+    }
+    reset(total);
+}
+
+void AllocProfile::PrintSummary() {
+    std::fprintf(stderr, "%-24s %12s %12s %14s %14s\n", "region", "allocs", "frees", "bytes", "peak live");
+    int count = regionCount.load();
+    for (int i = 0; i <= count; i++) {
+        const char* name = i < count ? names[i] : "TOTAL";
+        Stats s = i < count ? load(counters[i]) : load(total);
+        if (s.allocations == 0 && i < count) {
+            continue;
+        }
+        std::fprintf(stderr, "%-24s %12llu %12llu %14llu %14llu\n", name,
+                     (unsigned long long)s.allocations, (unsigned long long)s.frees,
+                     (unsigned long long)s.bytes, (unsigned long long)s.peakLiveBytes);
+    }
+}
+
+AllocProfile::Scope::Scope(int region) : previous(currentRegion) {
+    currentRegion = region;
+}
+
+AllocProfile::Scope::~Scope() {
+    currentRegion = previous;
+}
+
+void* operator new(std::size_t size) {
+    void* ptr = profiled_alloc(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return profiled_alloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return profiled_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    profiled_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    profiled_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    profiled_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    profiled_free(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* ptr, std::size_t) noexcept {
+    profiled_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    profiled_free(ptr);
+}
+#endif
+
+#endif
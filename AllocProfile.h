@@ -0,0 +1,68 @@
+#ifndef ALLOCPROFILE_H
+#define ALLOCPROFILE_H
+
+// Opt-in heap allocation profiling. Build with -DALLOC_PROFILE and link
+// AllocProfile.cpp (see the *_prof targets in the Makefile) to replace the
+// global operator new/delete with counting versions. Without the flag
+// ALLOC_SCOPE compiles to nothing.
+//
+// ALLOC_SCOPE("name") tags every allocation made on this thread until the
+// end of the enclosing block with the region "name" (the innermost scope
+// wins). Allocations outside any scope go to "(untagged)". A summary of
+// every region is printed to stderr at exit.
+
+#ifdef ALLOC_PROFILE
+
+#include <cstdint>
+#include <cstddef>
+
+namespace AllocProfile {
+    struct Stats {
+        uint64_t allocations = 0;   // Calls to operator new
+        uint64_t frees = 0;         // Calls to operator delete
+        uint64_t bytes = 0;         // Total bytes requested
+        uint64_t liveBytes = 0;     // Bytes allocated here and not yet freed
+        uint64_t peakLiveBytes = 0; // Highest liveBytes seen
+    };
+
+    // Returns the id for a region name, registering it on first use.
+    // name must outlive the program (a string literal).
+    int Region(const char* name);
+
+    // Counters for one region, or for all regions combined. Return false if
+    // no region has that name.
+    bool Get(const char* name, Stats& stats);
+    Stats Total();
+
+    // Zeroes the counters (live bytes are kept, peaks restart from them) so
+    // a benchmark can measure one phase at a time.
+    void Reset();
+
+    // Prints one line per region to stderr.
+    void PrintSummary();
+
+    // Makes region the current tag for this thread until destroyed.
+    class Scope {
+        public:
+            explicit Scope(int region);
+            ~Scope();
+
+        private:
+            int previous;
+
+    };
+}
+
+#define ALLOC_SCOPE_CONCAT2(a, b) a##b
+#define ALLOC_SCOPE_CONCAT(a, b) ALLOC_SCOPE_CONCAT2(a, b)
+#define ALLOC_SCOPE(name) \
+    static const int ALLOC_SCOPE_CONCAT(alloc_region_, __LINE__) = AllocProfile::Region(name); \
+    AllocProfile::Scope ALLOC_SCOPE_CONCAT(alloc_scope_, __LINE__)(ALLOC_SCOPE_CONCAT(alloc_region_, __LINE__))
+
+#else
+
+#define ALLOC_SCOPE(name)
+
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "LaunchQuery.h"
+
+using namespace std;
+
+/**
+ * Sends one request to the launch server and prints the response, e.g.
+ *   ./nasaq AVG company=SpaceX from=2015-01-01
+ * With no request, reads one request per line from standard input.
+ * --socket PATH picks the server (default /tmp/nasa_launch.sock).
+ */
+int main(int argc, char* argv[]) {
+    string socket_path = "/tmp/nasa_launch.sock";
+    vector<string> words;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else {
+            words.push_back(argv[i]);
+        }
+    }
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        cout << "Socket path is too long!" << endl;
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        cout << "Error connecting to " << socket_path << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    vector<string> requests;
+    if (!words.empty()) {
+        requests.push_back(join_query(words));
+    } else {
+        string line;
+        while (getline(cin, line)) {
+            requests.push_back(line);
+        }
+    }
+
+    int status = 0;
+    string pending;
+    char buffer[4096];
+    for (const string& request : requests) {
+        string message = request + "\n";
+        if (write(fd, message.data(), message.size()) != static_cast<ssize_t>(message.size())) {
+            cout << "Error sending request!" << endl;
+            return 1;
+        }
+
+        // Each request gets exactly one response line
+        size_t eol;
+        while ((eol = pending.find('\n')) == string::npos) {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                cout << "Server closed the connection!" << endl;
+                return 1;
+            }
+            pending.append(buffer, static_cast<size_t>(n));
+        }
+        string response = pending.substr(0, eol);
+        pending.erase(0, eol + 1);
+
+        cout << response << endl;
+        if (response.compare(0, 3, "ERR") == 0) {
+            status = 1;
+        }
+    }
+
+    close(fd);
+    return status;
+}
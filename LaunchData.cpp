@@ -0,0 +1,242 @@
+#include "LaunchData.h"
+#include "AllocProfile.h"
+#include <sstream>   // For parsing the HH:MM time
+#include <stdexcept> // For out_of_range
+
+using namespace std;
+
+/**
+ * Splits a CSV line into fields, handling quoted values correctly.
+ * @param line The CSV line to split.
+ * @return A vector of parsed fields.
+ */
+vector<string> split_csv(const string &line) {
+    ALLOC_SCOPE("split_csv");
+    vector<string> result;
+    string field;
+    bool inside_quotes = false;
+
+    for (char ch : line) {
+        if (ch == '"') {
+            inside_quotes = !inside_quotes;  // Toggle quote tracking
+        } else if (ch == ',' && !inside_quotes) {
+            result.push_back(field);  // Add the completed field to the result vector
+            field.clear();  // Reset field for the next entry
+        } else {
+            field += ch;  // Append character to the current field
+        }
+    }
+
+    result.push_back(field);  // Add last field
+    return result;
+}
+
+/**
+ * Extracts the time (HH:MM) from a "Datum" value such as "Fri Aug 07, 2020 05:12 UTC".
+ * @param datum The Datum column of a row.
+ * @return A TimeCode object representing the time, or TimeCode(-1, -1, -1) if there is none.
+ */
+TimeCode parse_datum_time(const string &datum) {
+    ALLOC_SCOPE("parse_datum_time");
+    // Locate the UTC position in the string
+    size_t utc_pos = datum.rfind(" UTC");
+    if (utc_pos == string::npos || utc_pos == 0) {
+        return TimeCode(-1, -1, -1);  // Return invalid if "UTC" is not found
+    }
+
+    // Find the space before the time portion
+    size_t time_start = datum.rfind(" ", utc_pos - 1);
+    if (time_start == string::npos) {
+        return TimeCode(-1, -1, -1);
+    }
+
+    string time_part = datum.substr(time_start + 1, utc_pos - time_start - 1);
+
+    // Validate and extract hours/minutes
+    istringstream iss(time_part);
+    unsigned int hours, minutes;
+    char sep;
+    if (!(iss >> hours >> sep >> minutes) || sep != ':') {
+        return TimeCode(-1, -1, -1);  // Return invalid if parsing fails
+    }
+
+    return TimeCode(hours, minutes, 0);
+}
+
+/**
+ * Counts days from 1970-01-01 to a proleptic Gregorian date.
+ * @return Days since the epoch (negative before 1970).
+ */
+int32_t days_from_civil(int year, unsigned int month, unsigned int day) {
+    year -= month <= 2;  // Count March as the first month so leap days fall last
+    int era = (year >= 0 ? year : year - 399) / 400;
+    unsigned int yoe = static_cast<unsigned int>(year - era * 400);
+    unsigned int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+/**
+ * Extracts the launch date from a "Datum" value such as "Fri Aug 07, 2020 05:12 UTC".
+ * @param datum The Datum column of a row.
+ * @param day Set to days since 1970-01-01.
+ * @return False if the value does not start with a date.
+ */
+bool parse_datum_day(const string &datum, int32_t &day) {
+    ALLOC_SCOPE("parse_datum_day");
+    static const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                   "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+    istringstream iss(datum);
+    string weekday, month_name;
+    unsigned int mday;
+    char comma;
+    int year;
+    if (!(iss >> weekday >> month_name >> mday >> comma >> year) || comma != ',') {
+        return false;
+    }
+
+    for (unsigned int month = 1; month <= 12; month++) {
+        if (month_name == months[month - 1]) {
+            if (mday < 1 || mday > 31) {
+                return false;
+            }
+            day = days_from_civil(year, month, mday);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Extracts and parses the time (HH:MM) from the "Datum" column.
+ * @param line The CSV line containing the timestamp.
+ * @return A TimeCode object representing the extracted time.
+ */
+TimeCode parse_line(const string &line) {
+    ALLOC_SCOPE("parse_line");
+    vector<string> fields = split_csv(line);
+
+    // Ensure we have enough columns to extract a valid time
+    if (fields.size() <= kDatumColumn) {
+        return TimeCode(-1, -1, -1);  // Return an invalid marker
+    }
+
+    return parse_datum_time(fields[kDatumColumn]);
+}
+
+// Returns true if the parsed time is a real time of day. Rows failing this
+// are skipped everywhere (exact, pipelined and sampled loads alike).
+bool is_valid_time(const TimeCode& time) {
+    return time.GetHours() < 24 && time.GetMinutes() < 60;
+}
+
+uint32_t StringDictionary::Intern(const string& value) {
+    auto it = codes.find(value);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    uint32_t code = static_cast<uint32_t>(values.size());
+    codes.emplace(value, code);
+    values.push_back(value);
+    return code;
+}
+
+uint32_t StringDictionary::Find(const string& value) const {
+    auto it = codes.find(value);
+    return it == codes.end() ? NotFound : it->second;
+}
+
+const string& StringDictionary::Lookup(uint32_t code) const {
+    if (code >= values.size()) {
+        throw out_of_range("Unknown dictionary code!");
+    }
+    return values[code];
+}
+
+bool LaunchTable::AddLine(const string& line) {
+    ALLOC_SCOPE("LaunchTable::AddLine");
+    vector<string> fields = split_csv(line);
+    if (fields.size() <= kDatumColumn) {
+        return false;
+    }
+
+    TimeCode time = parse_datum_time(fields[kDatumColumn]);
+    if (!is_valid_time(time)) {
+        return false;
+    }
+
+    int32_t launch_day;
+    if (!parse_datum_day(fields[kDatumColumn], launch_day)) {
+        launch_day = UnknownDay;
+    }
+
+    static const string empty;
+    times.push_back(TimeOfDay(time));
+    day.push_back(launch_day);
+    company.push_back(companies.Intern(fields[kCompanyColumn]));
+    rocketStatus.push_back(rocketStatuses.Intern(
+        fields.size() > kRocketStatusColumn ? fields[kRocketStatusColumn] : empty));
+    missionStatus.push_back(missionStatuses.Intern(
+        fields.size() > kMissionStatusColumn ? fields[kMissionStatusColumn] : empty));
+    return true;
+}
+
+// Builds old-code -> new-code for every entry of from.
+static vector<uint32_t> remap_codes(const StringDictionary& from, StringDictionary& into) {
+    vector<uint32_t> remap(from.size());
+    for (uint32_t code = 0; code < from.size(); code++) {
+        remap[code] = into.Intern(from.Lookup(code));
+    }
+    return remap;
+}
+
+void LaunchTable::Append(const LaunchTable& other) {
+    vector<uint32_t> companyMap = remap_codes(other.companies, companies);
+    vector<uint32_t> rocketMap = remap_codes(other.rocketStatuses, rocketStatuses);
+    vector<uint32_t> missionMap = remap_codes(other.missionStatuses, missionStatuses);
+
+    times.reserve(size() + other.size());
+    for (size_t i = 0; i < other.size(); i++) {
+        times.push_back(other.times[i]);
+        day.push_back(other.day[i]);
+        company.push_back(companyMap[other.company[i]]);
+        rocketStatus.push_back(rocketMap[other.rocketStatus[i]]);
+        missionStatus.push_back(missionMap[other.missionStatus[i]]);
+    }
+}
+
+bool LaunchTable::Matches(size_t i, const LaunchFilter& filter) const {
+    if (!((filter.company == LaunchFilter::Any || company[i] == filter.company) &&
+          (filter.rocketStatus == LaunchFilter::Any || rocketStatus[i] == filter.rocketStatus) &&
+          (filter.missionStatus == LaunchFilter::Any || missionStatus[i] == filter.missionStatus))) {
+        return false;
+    }
+    if (filter.fromDay == LaunchFilter::NoBound && filter.toDay == LaunchFilter::NoBound) {
+        return true;
+    }
+    // Any date bound excludes undated rows
+    return day[i] != UnknownDay &&
+           (filter.fromDay == LaunchFilter::NoBound || day[i] >= filter.fromDay) &&
+           (filter.toDay == LaunchFilter::NoBound || day[i] <= filter.toDay);
+}
+
+void LaunchTable::Summarize(const LaunchFilter& filter, size_t& count, long long unsigned int& sumSeconds) const {
+    count = 0;
+    sumSeconds = 0;
+    for (size_t i = 0; i < size(); i++) {
+        if (Matches(i, filter)) {
+            count++;
+            sumSeconds += times[i].GetTimeCodeAsSeconds();
+        }
+    }
+}
+
+void LaunchTable::GroupByCompany(vector<size_t>& counts, vector<long long unsigned int>& sumSeconds) const {
+    counts.assign(companies.size(), 0);
+    sumSeconds.assign(companies.size(), 0);
+    for (size_t i = 0; i < size(); i++) {
+        counts[company[i]]++;
+        sumSeconds[company[i]] += times[i].GetTimeCodeAsSeconds();
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef LAUNCHDATA_H
+#define LAUNCHDATA_H
+
+#include <cstdint>       // For the integer dictionary codes
+#include <climits>       // For INT32_MIN / INT32_MAX day bounds
+#include <string>
+#include <vector>
+#include <unordered_map> // For the string -> code index
+#include "TimeCode.h"
+#include "TimeOfDay.h"
+
+using namespace std;
+
+// Column indexes in Space_Corrected.csv
+// (",Unnamed: 0,Company Name,Datum,Detail,Status Rocket, Rocket,Status Mission")
+const size_t kCompanyColumn = 2;
+const size_t kDatumColumn = 3;
+const size_t kRocketStatusColumn = 5;
+const size_t kMissionStatusColumn = 7;
+
+vector<string> split_csv(const string &line);
+TimeCode parse_datum_time(const string &datum);
+bool parse_datum_day(const string &datum, int32_t &day);
+int32_t days_from_civil(int year, unsigned int month, unsigned int day);
+TimeCode parse_line(const string &line);
+bool is_valid_time(const TimeCode &time);
+
+// Maps each distinct string to a dense code (0, 1, 2, ...) so that columns
+// with a handful of repeated values can be stored and compared as integers.
+class StringDictionary {
+    public:
+        static const uint32_t NotFound = 0xFFFFFFFF;
+
+        // Returns the code for value, assigning the next one if it is new.
+        uint32_t Intern(const string& value);
+        // Returns the code for value, or NotFound; never adds.
+        uint32_t Find(const string& value) const;
+        const string& Lookup(uint32_t code) const;
+
+        size_t size() const { return values.size(); };
+
+    private:
+        unordered_map<string, uint32_t> codes;
+        vector<string> values;
+
+};
+
+// Restricts a query to rows whose codes match; Any matches every row.
+// fromDay/toDay are an inclusive range of days since 1970-01-01; NoBound
+// leaves that side open. Rows with an unknown date only match when both
+// sides are open.
+struct LaunchFilter {
+    static const uint32_t Any = 0xFFFFFFFE;
+    static const int32_t NoBound = INT32_MAX;
+
+    uint32_t company = Any;
+    uint32_t rocketStatus = Any;
+    uint32_t missionStatus = Any;
+    int32_t fromDay = NoBound;
+    int32_t toDay = NoBound;
+};
+
+// Launch rows kept column by column: a packed time of day, the launch
+// date, and one dictionary code per repeated-string column.
+class LaunchTable {
+    public:
+        // Day stored for rows whose date could not be parsed
+        static const int32_t UnknownDay = INT32_MIN;
+
+        // Parses one CSV row and appends it. Returns false (and stores
+        // nothing) when the row has no valid launch time.
+        bool AddLine(const string& line);
+
+        // Appends every row of other, translating its dictionary codes into
+        // this table's dictionaries.
+        void Append(const LaunchTable& other);
+
+        size_t size() const { return times.size(); };
+
+        TimeOfDay GetTime(size_t i) const { return times[i]; };
+        int32_t GetDay(size_t i) const { return day[i]; };
+        uint32_t GetCompany(size_t i) const { return company[i]; };
+        uint32_t GetRocketStatus(size_t i) const { return rocketStatus[i]; };
+        uint32_t GetMissionStatus(size_t i) const { return missionStatus[i]; };
+
+        bool Matches(size_t i, const LaunchFilter& filter) const;
+
+        // Number of matching rows and the sum of their times in seconds.
+        void Summarize(const LaunchFilter& filter, size_t& count, long long unsigned int& sumSeconds) const;
+
+        // Row counts and time sums indexed by company code.
+        void GroupByCompany(vector<size_t>& counts, vector<long long unsigned int>& sumSeconds) const;
+
+        long long unsigned int SumSeconds() const { return times.SumSeconds(); };
+
+        StringDictionary companies;
+        StringDictionary rocketStatuses;
+        StringDictionary missionStatuses;
+
+    private:
+        friend class LaunchSnapshot;  // Reads and writes the columns in bulk
+
+        PackedTimeOfDayArray times;
+        vector<int32_t> day;
+        vector<uint32_t> company;
+        vector<uint32_t> rocketStatus;
+        vector<uint32_t> missionStatus;
+
+};
+
+#endif
@@ -0,0 +1,625 @@
+#include <iostream>
+#include <assert.h>
+#include <cstdio>  // For remove
+#include <fstream>
+#include <iterator>  // For istreambuf_iterator
+#include <memory>
+#include <sys/stat.h>  // For mkdir
+#include <unistd.h>    // For rmdir
+#include "LaunchData.h"
+#include "LaunchPipeline.h"
+#include "LaunchQuery.h"
+#include "LaunchSampler.h"
+#include "LaunchScanner.h"
+#include "LaunchSnapshot.h"
+#include "RingBuffer.h"
+
+using namespace std;
+
+// Rows in the Space_Corrected.csv layout
+const string kSpaceXRow = "0,0,SpaceX,\"Fri Aug 07, 2020 05:12 UTC\",Falcon 9 Block 5 | Starlink V1 L9 & BlackSky,StatusActive,50,Success";
+const string kCascRow = "1,1,CASC,\"Thu Aug 06, 2020 04:01 UTC\",Long March 2D | Gaofen-9 04 & Q-SAT,StatusActive,29.75,Success";
+const string kSpaceXFailRow = "2,2,SpaceX,\"Tue Aug 04, 2020 23:57 UTC\",Starship Prototype | 150 Meter Hop,StatusActive,,Failure";
+const string kNoDayRow = "3,3,CASC,\"Sat Foo 01, 2020 08:00 UTC\",Long March 4B | Test,StatusActive,,Success";
+const string kNoTimeRow = "106,106,ISA,\"Thu Aug 29, 2019\",Safir-1B+ | Nahid-1,StatusActive,,Prelaunch Failure";
+
+
+void TestStringDictionary(){
+	cout << "Testing StringDictionary" << endl;
+	
+	StringDictionary dict;
+	
+	// test 1, codes are dense and stable
+	assert(dict.Intern("SpaceX") == 0);
+	assert(dict.Intern("CASC") == 1);
+	assert(dict.Intern("SpaceX") == 0);
+	assert(dict.size() == 2);
+	
+	// test 2, lookups both ways
+	assert(dict.Find("CASC") == 1);
+	assert(dict.Find("NASA") == StringDictionary::NotFound);
+	assert(dict.size() == 2);  // Find never adds
+	assert(dict.Lookup(0) == "SpaceX");
+	
+	// test 3, unknown code
+	try{
+		dict.Lookup(2);
+		assert(false);
+	} catch (const out_of_range& e){
+	}
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestAddLine(){
+	cout << "Testing AddLine" << endl;
+	
+	LaunchTable table;
+	assert(table.AddLine(kSpaceXRow));
+	assert(table.AddLine(kCascRow));
+	assert(table.AddLine(kSpaceXFailRow));
+	
+	// test 1, rows without a launch time are skipped
+	assert(!table.AddLine(kNoTimeRow));
+	assert(!table.AddLine("too,few"));
+	assert(table.size() == 3);
+	
+	// test 2, columns are stored as codes
+	assert(table.GetTime(0) == TimeOfDay(5, 12, 0));
+	assert(table.companies.Lookup(table.GetCompany(0)) == "SpaceX");
+	assert(table.GetCompany(0) == table.GetCompany(2));
+	assert(table.GetCompany(0) != table.GetCompany(1));
+	assert(table.rocketStatuses.size() == 1);
+	assert(table.missionStatuses.Lookup(table.GetMissionStatus(2)) == "Failure");
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestMatchesAndGroupBy(){
+	cout << "Testing Matches and GroupByCompany" << endl;
+	
+	LaunchTable table;
+	table.AddLine(kSpaceXRow);
+	table.AddLine(kCascRow);
+	table.AddLine(kSpaceXFailRow);
+	
+	// test 1, empty filter matches everything
+	LaunchFilter all;
+	size_t count;
+	long long unsigned int sum;
+	table.Summarize(all, count, sum);
+	assert(count == 3);
+	assert(sum == TimeCode(5, 12, 0).GetTimeCodeAsSeconds() + TimeCode(4, 1, 0).GetTimeCodeAsSeconds() +
+	              TimeCode(23, 57, 0).GetTimeCodeAsSeconds());
+	
+	// test 2, filtering on codes
+	LaunchFilter spacex;
+	spacex.company = table.companies.Find("SpaceX");
+	assert(table.Matches(0, spacex) && !table.Matches(1, spacex) && table.Matches(2, spacex));
+	spacex.missionStatus = table.missionStatuses.Find("Success");
+	table.Summarize(spacex, count, sum);
+	assert(count == 1 && sum == TimeCode(5, 12, 0).GetTimeCodeAsSeconds());
+	
+	// test 3, a name that is not in the dictionary matches nothing
+	LaunchFilter none;
+	none.company = table.companies.Find("NASA");
+	table.Summarize(none, count, sum);
+	assert(count == 0);
+	
+	// test 4, group by company
+	vector<size_t> counts;
+	vector<long long unsigned int> sums;
+	table.GroupByCompany(counts, sums);
+	assert(counts.size() == 2);
+	assert(counts[table.companies.Find("SpaceX")] == 2);
+	assert(counts[table.companies.Find("CASC")] == 1);
+	assert(sums[table.companies.Find("CASC")] == TimeCode(4, 1, 0).GetTimeCodeAsSeconds());
+	
+	cout << "PASSED!" << endl << endl;
+}
+	
+
+void TestAppend(){
+	cout << "Testing Append" << endl;
+	
+	// other interns its companies in a different order than table
+	LaunchTable table;
+	table.AddLine(kSpaceXRow);
+	LaunchTable other;
+	other.AddLine(kCascRow);
+	other.AddLine(kSpaceXFailRow);
+	assert(other.GetCompany(0) == 0);  // CASC is code 0 in other
+	
+	// test 1, codes are translated into table's dictionaries
+	table.Append(other);
+	assert(table.size() == 3);
+	assert(table.companies.size() == 2);
+	assert(table.companies.Lookup(table.GetCompany(1)) == "CASC");
+	assert(table.GetCompany(2) == table.GetCompany(0));
+	assert(table.missionStatuses.Lookup(table.GetMissionStatus(2)) == "Failure");
+	assert(table.GetTime(2) == TimeOfDay(23, 57, 0));
+	assert(table.GetDay(2) == other.GetDay(1));
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestSpscRing(){
+	cout << "Testing SpscRing" << endl;
+	
+	SpscRing<int> ring(3);
+	assert(ring.Capacity() == 4);  // Rounded up to a power of two
+	
+	// test 1, empty ring
+	int value = -1;
+	assert(!ring.TryPop(value));
+	assert(value == -1);
+	
+	// test 2, fill to capacity
+	for (int i = 0; i < 4; i++){
+		assert(ring.TryPush(i));
+	}
+	int extra = 4;
+	assert(!ring.TryPush(extra));
+	assert(ring.Size() == 4);
+	
+	// test 3, wraparound keeps FIFO order
+	for (int round = 0; round < 3; round++){
+		for (int i = 0; i < 4; i++){
+			assert(ring.TryPop(value));
+			assert(value == round * 4 + i);
+			int next = (round + 1) * 4 + i;
+			assert(ring.TryPush(next));
+		}
+	}
+	for (int i = 0; i < 4; i++){
+		assert(ring.TryPop(value));
+		assert(value == 12 + i);
+	}
+	assert(!ring.TryPop(value));
+	assert(ring.Size() == 0);
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestMpscRing(){
+	cout << "Testing MpscRing" << endl;
+	
+	MpscRing<unique_ptr<int> > ring(4);
+	assert(ring.Capacity() == 4);
+	
+	// test 1, empty ring
+	unique_ptr<int> value;
+	assert(!ring.TryPop(value));
+	
+	// test 2, fill to capacity
+	for (int i = 0; i < 4; i++){
+		unique_ptr<int> item(new int(i));
+		assert(ring.TryPush(item));
+		assert(!item);  // Moved into the ring
+	}
+	unique_ptr<int> extra(new int(4));
+	assert(!ring.TryPush(extra));
+	assert(extra && *extra == 4);  // Left with the caller when full
+	
+	// test 3, wraparound keeps FIFO order
+	for (int round = 0; round < 3; round++){
+		for (int i = 0; i < 4; i++){
+			assert(ring.TryPop(value));
+			assert(*value == round * 4 + i);
+			unique_ptr<int> next(new int((round + 1) * 4 + i));
+			assert(ring.TryPush(next));
+		}
+	}
+	for (int i = 0; i < 4; i++){
+		assert(ring.TryPop(value));
+		assert(*value == 12 + i);
+	}
+	assert(!ring.TryPop(value));
+	assert(ring.Size() == 0);
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestPipelineBlockSize(){
+	cout << "Testing LaunchPipeline block sizes" << endl;
+	
+	const string path = "ldt_pipeline.csv";
+	{
+		ofstream out(path);
+		out << ",Unnamed: 0,Company Name,Datum,Detail,Status Rocket, Rocket,Status Mission" << endl;
+		for (int i = 0; i < 50; i++){
+			out << kSpaceXRow << endl << kCascRow << endl << kSpaceXFailRow << endl << kNoTimeRow << endl;
+		}
+	}
+	
+	// test 1, a block smaller than one row gives the same table as one big block
+	PipelineOptions small;
+	small.blockSize = 64;
+	small.workers = 3;
+	LaunchTable smallTable;
+	LaunchPipeline smallPipeline(small);
+	assert(smallPipeline.Run(path, smallTable));
+	
+	LaunchTable bigTable;
+	LaunchPipeline bigPipeline;
+	assert(bigPipeline.Run(path, bigTable));
+	remove(path.c_str());
+	
+	assert(smallTable.size() == 150);
+	assert(bigTable.size() == 150);
+	assert(smallPipeline.SkippedRows() == 50);
+	assert(bigPipeline.SkippedRows() == 50);
+	
+	// Batches may land out of order, so compare per-company totals by name
+	vector<size_t> smallCounts, bigCounts;
+	vector<long long unsigned int> smallSums, bigSums;
+	smallTable.GroupByCompany(smallCounts, smallSums);
+	bigTable.GroupByCompany(bigCounts, bigSums);
+	assert(smallCounts.size() == bigCounts.size());
+	for (size_t code = 0; code < smallCounts.size(); code++){
+		uint32_t bigCode = bigTable.companies.Find(smallTable.companies.Lookup(code));
+		assert(smallCounts[code] == bigCounts[bigCode]);
+		assert(smallSums[code] == bigSums[bigCode]);
+	}
+	
+	// test 2, a missing file
+	LaunchTable missing;
+	assert(!bigPipeline.Run("ldt_missing.csv", missing));
+	
+	cout << "PASSED!" << endl << endl;
+}
+	
+
+void TestDates(){
+	cout << "Testing days_from_civil and parse_datum_day" << endl;
+	
+	// test 1, known days
+	assert(days_from_civil(1970, 1, 1) == 0);
+	assert(days_from_civil(1970, 1, 2) == 1);
+	assert(days_from_civil(1969, 12, 31) == -1);
+	assert(days_from_civil(2000, 3, 1) - days_from_civil(2000, 2, 28) == 2);  // Leap year
+	assert(days_from_civil(1900, 3, 1) - days_from_civil(1900, 2, 28) == 1);  // Not a leap year
+	assert(days_from_civil(2020, 8, 7) == 18481);
+	assert(days_from_civil(1957, 10, 4) == -4472);
+	
+	// test 2, datum strings
+	int32_t day = 0;
+	assert(parse_datum_day("Fri Aug 07, 2020 05:12 UTC", day));
+	assert(day == 18481);
+	assert(parse_datum_day("Thu Aug 29, 2019", day));
+	assert(day == days_from_civil(2019, 8, 29));
+	
+	// test 3, bad datums leave day alone
+	day = 7;
+	assert(!parse_datum_day("Sat Foo 01, 2020 08:00 UTC", day));
+	assert(!parse_datum_day("Fri Aug 32, 2020", day));
+	assert(!parse_datum_day("Fri Aug 07 2020", day));
+	assert(!parse_datum_day("", day));
+	assert(day == 7);
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestSplitJoinQuery(){
+	cout << "Testing split_query and join_query" << endl;
+	
+	// test 1, plain words and extra whitespace
+	vector<string> words = split_query("  COUNT\tcompany=CASC  \r");
+	assert(words.size() == 2);
+	assert(words[0] == "COUNT" && words[1] == "company=CASC");
+	
+	// test 2, quoted values keep their spaces
+	words = split_query("AVG company=\"Rocket Lab\" mission=Success");
+	assert(words.size() == 3);
+	assert(words[1] == "company=Rocket Lab");
+	
+	// test 3, round trip
+	assert(join_query(words) == "AVG company=\"Rocket Lab\" mission=Success");
+	assert(split_query(join_query(words)) == words);
+	assert(join_query(vector<string>{"a b"}) == "\"a b\"");
+	
+	// test 4, empty
+	assert(split_query("").empty());
+	assert(split_query("   ").empty());
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestAnswerQuery(){
+	cout << "Testing answer_query" << endl;
+	
+	LaunchTable table;
+	table.AddLine(kSpaceXRow);       // 2020-08-07 05:12
+	table.AddLine(kCascRow);         // 2020-08-06 04:01
+	table.AddLine(kSpaceXFailRow);   // 2020-08-04 23:57
+	assert(table.AddLine(kNoDayRow)); // Unknown date, 08:00
+	assert(table.GetDay(3) == LaunchTable::UnknownDay);
+	
+	// test 1, commands
+	assert(answer_query(table, "PING") == "OK 4");
+	assert(answer_query(table, "COUNT") == "OK 4");
+	assert(answer_query(table, "MIN") == "OK 4:1:0 4");
+	assert(answer_query(table, "MAX") == "OK 23:57:0 4");
+	assert(answer_query(table, "AVG company=SpaceX") == "OK 14:34:30 2");
+	assert(answer_query(table, "PCT 50") == "OK 5:12:0 4");
+	assert(answer_query(table, "PCT 0 company=SpaceX") == "OK 5:12:0 2");
+	assert(answer_query(table, "PCT 100") == "OK 23:57:0 4");
+	
+	// test 2, filters
+	assert(answer_query(table, "COUNT company=CASC mission=Success") == "OK 2");
+	assert(answer_query(table, "COUNT rocket=StatusActive mission=Failure") == "OK 1");
+	assert(answer_query(table, "COUNT company=NASA") == "OK 0");
+	assert(answer_query(table, "AVG company=NASA") == "ERR no matching launches");
+	
+	// test 3, either date bound excludes the undated row
+	assert(answer_query(table, "COUNT from=2020-08-06") == "OK 2");
+	assert(answer_query(table, "COUNT to=2020-08-06") == "OK 2");
+	assert(answer_query(table, "COUNT from=1900-01-01") == "OK 3");
+	assert(answer_query(table, "COUNT to=2100-01-01") == "OK 3");
+	assert(answer_query(table, "MIN from=2020-08-05 to=2020-08-06") == "OK 4:1:0 1");
+	
+	// test 4, errors
+	assert(answer_query(table, "") == "ERR empty request");
+	assert(answer_query(table, "SUM").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "PCT").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "PCT 101").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "PCT 5x").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT company").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT when=now").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT from=2020-13-01").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "PCT nan").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "PCT inf").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "PCT -inf").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT from=2020-02-30").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT to=2019-02-29").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT to=2100-02-29").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT from=2020-04-31").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT from=2020-01-01xyz").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT from=2020-01-01-02").compare(0, 4, "ERR ") == 0);
+	assert(answer_query(table, "COUNT from=2020-02-29") == "OK 3");  // Leap day
+	assert(answer_query(table, "COUNT to=2000-02-29") == "OK 0");
+	
+	cout << "PASSED!" << endl << endl;
+}
+	
+
+// Writes text to path, creating or replacing it.
+void write_file(const string &path, const string &text){
+	ofstream out(path, ios::binary);
+	out << text;
+}
+
+
+void TestScannerChunks(){
+	cout << "Testing LaunchScanner chunk boundaries" << endl;
+	
+	// Header longer than the small chunks, and no newline after the last row
+	const string path = "ldt_scanner.csv";
+	const string header = ",Unnamed: 0,Company Name,Datum,Detail,Status Rocket, Rocket,Status Mission";
+	write_file(path, header + "\n" + kSpaceXRow + "\n" + kCascRow + "\n" + kNoTimeRow + "\n" + kSpaceXFailRow);
+	const uint64_t size = header.size() + kSpaceXRow.size() + kCascRow.size() + kNoTimeRow.size() +
+	                      kSpaceXFailRow.size() + 4;
+	const long long unsigned int expectedSum = TimeCode(5, 12, 0).GetTimeCodeAsSeconds() +
+	                                           TimeCode(4, 1, 0).GetTimeCodeAsSeconds() +
+	                                           TimeCode(23, 57, 0).GetTimeCodeAsSeconds();
+	
+	// test 1, every chunk size puts the edges somewhere different: inside
+	// the header, inside rows, right after newlines; each row is read once
+	for (uint64_t chunkSize = 1; chunkSize <= size + 1; chunkSize++){
+		LaunchScanner scanner(3, chunkSize);
+		LaunchTable table;
+		string error;
+		assert(scanner.Run(vector<string>{path}, table, error));
+		size_t count;
+		long long unsigned int sum;
+		table.Summarize(LaunchFilter(), count, sum);
+		assert(count == 3);
+		assert(sum == expectedSum);
+		assert(scanner.SkippedRows() == 1);
+	}
+	
+	// test 2, the same file twice counts twice
+	LaunchScanner scanner(2, 50);
+	LaunchTable table;
+	string error;
+	assert(scanner.Run(vector<string>{path, path}, table, error));
+	assert(table.size() == 6);
+	assert(scanner.SkippedRows() == 2);
+	remove(path.c_str());
+	
+	// test 3, a file that disappeared
+	LaunchScanner missing(2, 50);
+	assert(!missing.Run(vector<string>{path}, table, error));
+	assert(error == "Error opening " + path);
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+
+void TestExpandInputs(){
+	cout << "Testing expand_launch_inputs" << endl;
+	
+	mkdir("ldt_inputs", 0755);
+	mkdir("ldt_inputs/sub", 0755);
+	write_file("ldt_inputs/b.csv", "");
+	write_file("ldt_inputs/a.csv", "");
+	write_file("ldt_inputs/notes.txt", "");
+	write_file("ldt_inputs/sub/c.csv", "");
+	write_file("ldt_inputs/a.csv.snap", "");
+	
+	// test 1, a directory is searched recursively for *.csv in sorted order
+	vector<string> files;
+	string error;
+	assert(expand_launch_inputs(vector<string>{"ldt_inputs"}, files, error));
+	assert((files == vector<string>{"ldt_inputs/a.csv", "ldt_inputs/b.csv", "ldt_inputs/sub/c.csv"}));
+	
+	// test 2, a glob and a plain file, appended in input order
+	files.clear();
+	assert(expand_launch_inputs(vector<string>{"ldt_inputs/notes.txt", "ldt_inputs/*.csv"}, files, error));
+	assert((files == vector<string>{"ldt_inputs/notes.txt", "ldt_inputs/a.csv", "ldt_inputs/b.csv"}));
+	
+	// test 3, glob matches follow the *.csv rule too, so snapshots are left out
+	files.clear();
+	assert(expand_launch_inputs(vector<string>{"ldt_inputs/*"}, files, error));
+	assert((files == vector<string>{"ldt_inputs/a.csv", "ldt_inputs/b.csv", "ldt_inputs/sub/c.csv"}));
+	
+	// test 4, an input that matches nothing
+	files.clear();
+	assert(!expand_launch_inputs(vector<string>{"ldt_inputs/a.csv", "ldt_inputs/*.json"}, files, error));
+	assert(error == "No launch files found for ldt_inputs/*.json");
+	assert(!expand_launch_inputs(vector<string>{"ldt_missing"}, files, error));
+	
+	remove("ldt_inputs/sub/c.csv");
+	rmdir("ldt_inputs/sub");
+	remove("ldt_inputs/a.csv");
+	remove("ldt_inputs/a.csv.snap");
+	remove("ldt_inputs/b.csv");
+	remove("ldt_inputs/notes.txt");
+	rmdir("ldt_inputs");
+	
+	cout << "PASSED!" << endl << endl;
+}
+	
+
+// Loads path's snapshot and checks it holds the rows of expected.
+bool snapshot_matches(const string &path, const LaunchTable &expected, uint64_t expectedSkipped){
+	LaunchTable table;
+	uint64_t skipped = 0;
+	if (!LaunchSnapshot::Load(path, table, skipped)){
+		return false;
+	}
+	assert(table.size() == expected.size());
+	assert(skipped == expectedSkipped);
+	for (size_t i = 0; i < table.size(); i++){
+		assert(table.GetTime(i) == expected.GetTime(i));
+		assert(table.GetDay(i) == expected.GetDay(i));
+		assert(table.companies.Lookup(table.GetCompany(i)) == expected.companies.Lookup(expected.GetCompany(i)));
+		assert(table.rocketStatuses.Lookup(table.GetRocketStatus(i)) ==
+		       expected.rocketStatuses.Lookup(expected.GetRocketStatus(i)));
+		assert(table.missionStatuses.Lookup(table.GetMissionStatus(i)) ==
+		       expected.missionStatuses.Lookup(expected.GetMissionStatus(i)));
+	}
+	return true;
+}
+
+
+void TestSnapshot(){
+	cout << "Testing LaunchSnapshot" << endl;
+	
+	const string path = "ldt_snapshot.csv";
+	const string snap = LaunchSnapshot::PathFor(path);
+	write_file(path, "header\n" + kSpaceXRow + "\n" + kCascRow + "\n" + kNoTimeRow + "\n" + kNoDayRow + "\n");
+	LaunchTable table;
+	table.AddLine(kSpaceXRow);
+	table.AddLine(kCascRow);
+	table.AddLine(kNoDayRow);
+	FileStamp stamp;
+	assert(stat_file(path, stamp));
+	
+	// test 1, no snapshot yet
+	remove(snap.c_str());
+	assert(!snapshot_matches(path, table, 1));
+	
+	// test 2, round trip
+	assert(LaunchSnapshot::Write(path, stamp, table, 1));
+	assert(snapshot_matches(path, table, 1));
+	
+	// test 3, a stamp that no longer matches the CSV
+	FileStamp stale = stamp;
+	stale.size++;
+	assert(LaunchSnapshot::Write(path, stale, table, 1));
+	assert(!snapshot_matches(path, table, 1));
+	
+	// test 4, one flipped payload byte fails the checksum
+	assert(LaunchSnapshot::Write(path, stamp, table, 1));
+	string bytes;
+	{
+		ifstream in(snap, ios::binary);
+		bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+	}
+	string flipped = bytes;
+	flipped[flipped.size() - 3] ^= 0x10;
+	write_file(snap, flipped);
+	assert(!snapshot_matches(path, table, 1));
+	
+	// test 5, truncated files, at every length
+	for (size_t length = 0; length < bytes.size(); length += 7){
+		write_file(snap, bytes.substr(0, length));
+		assert(!snapshot_matches(path, table, 1));
+	}
+	
+	// test 6, intact again
+	write_file(snap, bytes);
+	assert(snapshot_matches(path, table, 1));
+	
+	remove(snap.c_str());
+	remove(path.c_str());
+	
+	cout << "PASSED!" << endl << endl;
+}
+	
+
+void TestSampler(){
+	cout << "Testing LaunchSampler" << endl;
+	
+	const string path = "ldt_sampler.csv";
+	SampleOptions options;
+	options.seed = 1;
+	SampleEstimate estimate;
+	
+	// test 1, no valid rows ends with an error instead of sampling forever
+	string rows = "header\n";
+	for (int i = 0; i < 200; i++){
+		rows += kNoTimeRow + "\n";
+	}
+	write_file(path, rows);
+	LaunchSampler sampler(options);
+	assert(!sampler.Run(path, estimate));
+	
+	// test 2, a file smaller than the sample is read exactly
+	rows = "header\n";
+	for (int i = 0; i < 100; i++){
+		rows += kSpaceXRow + "\n" + kNoTimeRow + "\n" + kCascRow + "\n";
+	}
+	write_file(path, rows);
+	assert(sampler.Run(path, estimate));
+	assert(estimate.exact && estimate.converged);
+	assert(estimate.samples == 200 && estimate.skipped == 100);
+	assert(estimate.average == (TimeCode(5, 12, 0) + TimeCode(4, 1, 0)) / 2);
+	assert(estimate.halfWidthSeconds == 0);
+	
+	// test 3, a missing file
+	remove(path.c_str());
+	assert(!sampler.Run(path, estimate));
+	
+	cout << "PASSED!" << endl << endl;
+}
+	
+	
+int main(){
+	
+	TestStringDictionary();
+	TestAddLine();
+	TestMatchesAndGroupBy();
+	TestAppend();
+	TestSpscRing();
+	TestMpscRing();
+	TestPipelineBlockSize();
+	TestDates();
+	TestSplitJoinQuery();
+	TestAnswerQuery();
+	TestScannerChunks();
+	TestExpandInputs();
+	TestSnapshot();
+	TestSampler();
+	
+	cout << "PASSED ALL TESTS!!!" << endl;
+	return 0;
+}
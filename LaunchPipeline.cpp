@@ -0,0 +1,253 @@
+#include "LaunchPipeline.h"
+#include "AllocProfile.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm> // For min
+#include <chrono>
+#include <thread>    // For the stage threads, yield and sleep_for
+
+using namespace std;
+
+// Longest a stalled stage sleeps before checking its queue again.
+static const chrono::microseconds kMaxBackoff(500);
+
+// Waits a little longer on each call: a few yields first (the other side
+// is usually about to catch up), then sleeps that double up to kMaxBackoff,
+// so a stage stuck behind a slow one stops burning a core.
+class Backoff {
+    public:
+        void Pause() {
+            if (yields < kYields) {
+                yields++;
+                this_thread::yield();
+                return;
+            }
+            this_thread::sleep_for(delay);
+            delay = min(delay * 2, kMaxBackoff);
+        }
+
+    private:
+        static const unsigned int kYields = 16;
+        unsigned int yields = 0;
+        chrono::microseconds delay{1};
+
+};
+
+// Pushes value, backing off while the queue is full. A wait counts as one stall.
+template <class Ring, class T>
+static void push_blocking(Ring& ring, T& value, StageStats& stats) {
+    if (ring.TryPush(value)) {
+        return;
+    }
+    stats.fullStalls++;
+    Backoff backoff;
+    while (!ring.TryPush(value)) {
+        backoff.Pause();
+    }
+}
+
+// Pops into value, backing off while the queue is empty. A wait counts as one stall.
+template <class Ring, class T>
+static void pop_blocking(Ring& ring, T& value, StageStats& stats) {
+    stats.RecordOccupancy(ring.Size());
+    if (ring.TryPop(value)) {
+        return;
+    }
+    stats.emptyStalls++;
+    Backoff backoff;
+    while (!ring.TryPop(value)) {
+        backoff.Pause();
+    }
+}
+
+void StageStats::RecordOccupancy(uint64_t queued) {
+    occupancySum += queued;
+    occupancySamples++;
+    uint64_t seen = occupancyMax.load();
+    while (queued > seen && !occupancyMax.compare_exchange_weak(seen, queued)) {
+    }
+}
+
+double StageStats::AverageOccupancy() const {
+    uint64_t n = occupancySamples.load();
+    return n == 0 ? 0.0 : static_cast<double>(occupancySum.load()) / n;
+}
+
+string StageStats::ToString() const {
+    ostringstream oss;
+    oss << items.load() << " items, " << fullStalls.load() << " full stalls, "
+        << emptyStalls.load() << " empty stalls, input occupancy avg "
+        << fixed << setprecision(2) << AverageOccupancy() << " max " << occupancyMax.load();
+    return oss.str();
+}
+
+LaunchPipeline::LaunchPipeline(const PipelineOptions& options) : options(options) {
+    if (this->options.workers == 0) {
+        unsigned int cores = thread::hardware_concurrency();
+        this->options.workers = cores > 2 ? cores - 2 : 1;  // Leave the reader and aggregator a core
+    }
+    if (this->options.blockSize == 0) {
+        this->options.blockSize = 1;
+    }
+}
+
+// Gives block to the next worker whose queue has room, starting after the
+// last one used; waits only when every worker is backed up.
+void LaunchPipeline::Dispatch(vector<unique_ptr<SpscRing<unique_ptr<Block> > > >& inputs, unique_ptr<Block>& block) {
+    bool stalled = false;
+    Backoff backoff;
+    while (true) {
+        for (size_t i = 0; i < inputs.size(); i++) {
+            size_t worker = (nextWorker + i) % inputs.size();
+            if (inputs[worker]->TryPush(block)) {
+                nextWorker = (worker + 1) % inputs.size();
+                readerStats.items++;
+                return;
+            }
+        }
+        if (!stalled) {
+            readerStats.fullStalls++;
+            stalled = true;
+        }
+        backoff.Pause();
+    }
+}
+
+// Fills blocks of about blockSize bytes, cut at the last newline, and deals
+// them to the workers. Ends by sending each worker a last marker.
+void LaunchPipeline::ReadStage(const string& path, vector<unique_ptr<SpscRing<unique_ptr<Block> > > >& inputs) {
+    ALLOC_SCOPE("LaunchPipeline::ReadStage");
+    ifstream file(path, ios::binary);
+    string carry;  // Partial line left over from the previous read
+    bool header = true;
+
+    vector<char> buffer(options.blockSize);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        size_t got = static_cast<size_t>(file.gcount());
+        if (got == 0) {
+            break;
+        }
+
+        unique_ptr<Block> block(new Block);
+        block->text.reserve(carry.size() + got);
+        block->text.swap(carry);
+        block->text.append(buffer.data(), got);
+
+        size_t start = 0;
+        if (header) {
+            size_t eol = block->text.find('\n');
+            if (eol == string::npos) {
+                carry.swap(block->text);  // Header is longer than a block
+                continue;
+            }
+            start = eol + 1;  // Skip header row
+            header = false;
+        }
+
+        size_t end = block->text.rfind('\n');
+        if (end == string::npos || end < start) {
+            carry.assign(block->text, start, string::npos);  // No complete row yet
+            continue;
+        }
+        carry.assign(block->text, end + 1, string::npos);
+        block->text.erase(end + 1);
+        if (start > 0) {
+            block->text.erase(0, start);
+        }
+
+        Dispatch(inputs, block);
+    }
+
+    // Last row may have no trailing newline
+    if (!header && !carry.empty()) {
+        unique_ptr<Block> block(new Block);
+        block->text.swap(carry);
+        Dispatch(inputs, block);
+    }
+
+    for (auto& input : inputs) {
+        unique_ptr<Block> done(new Block);
+        done->last = true;
+        push_blocking(*input, done, readerStats);
+    }
+}
+
+// Parses each block into its own batch table (with its own dictionaries, so
+// workers never share state) and hands it to the aggregator.
+void LaunchPipeline::ParseStage(SpscRing<unique_ptr<Block> >& input, MpscRing<unique_ptr<Batch> >& output) {
+    ALLOC_SCOPE("LaunchPipeline::ParseStage");
+    while (true) {
+        unique_ptr<Block> block;
+        pop_blocking(input, block, parserStats);
+
+        unique_ptr<Batch> batch(new Batch);
+        if (block->last) {
+            batch->last = true;
+            push_blocking(output, batch, parserStats);
+            return;
+        }
+
+        const string& text = block->text;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t eol = text.find('\n', pos);
+            if (eol == string::npos) {
+                eol = text.size();
+            }
+            if (!batch->rows.AddLine(text.substr(pos, eol - pos))) {
+                batch->skipped++;  // Row has no valid launch time
+            }
+            pos = eol + 1;
+        }
+
+        parserStats.items++;
+        push_blocking(output, batch, parserStats);
+    }
+}
+
+bool LaunchPipeline::Run(const string& path, LaunchTable& table) {
+    if (!ifstream(path).is_open()) {
+        return false;
+    }
+
+    vector<unique_ptr<SpscRing<unique_ptr<Block> > > > inputs;
+    for (unsigned int i = 0; i < options.workers; i++) {
+        inputs.emplace_back(new SpscRing<unique_ptr<Block> >(options.queueDepth));
+    }
+    MpscRing<unique_ptr<Batch> > output(options.queueDepth * options.workers);
+
+    vector<thread> threads;
+    threads.emplace_back(&LaunchPipeline::ReadStage, this, cref(path), ref(inputs));
+    for (unsigned int i = 0; i < options.workers; i++) {
+        threads.emplace_back(&LaunchPipeline::ParseStage, this, ref(*inputs[i]), ref(output));
+    }
+
+    // Aggregate on this thread until every worker has sent its last batch
+    unsigned int running = options.workers;
+    while (running > 0) {
+        unique_ptr<Batch> batch;
+        pop_blocking(output, batch, aggregatorStats);
+        if (batch->last) {
+            running--;
+            continue;
+        }
+        table.Append(batch->rows);
+        skippedRows += batch->skipped;
+        aggregatorStats.items++;
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    return true;
+}
+
+string LaunchPipeline::StatsToString() const {
+    ostringstream oss;
+    oss << "reader:     " << readerStats.ToString() << endl
+        << "parsers:    " << parserStats.ToString() << " (" << options.workers << " threads)" << endl
+        << "aggregator: " << aggregatorStats.ToString() << endl;
+    return oss.str();
+}
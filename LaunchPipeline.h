@@ -0,0 +1,85 @@
+#ifndef LAUNCHPIPELINE_H
+#define LAUNCHPIPELINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "LaunchData.h"
+#include "RingBuffer.h"
+
+using namespace std;
+
+// Counters for one pipeline stage. They are atomics so another thread (or a
+// progress printer) can read them while the pipeline runs.
+struct StageStats {
+    atomic<uint64_t> items{0};          // Blocks/batches this stage finished
+    atomic<uint64_t> fullStalls{0};     // Times the stage waited on a full output queue
+    atomic<uint64_t> emptyStalls{0};    // Times the stage waited on an empty input queue
+    atomic<uint64_t> occupancySum{0};   // Input queue length summed over every pop
+    atomic<uint64_t> occupancySamples{0};
+    atomic<uint64_t> occupancyMax{0};   // Longest input queue seen
+
+    void RecordOccupancy(uint64_t queued);
+    double AverageOccupancy() const;
+    string ToString() const;
+};
+
+struct PipelineOptions {
+    size_t blockSize = 1 << 20;  // Bytes per read; rows never straddle blocks
+    unsigned int workers = 0;    // Parser threads; 0 = one per spare core
+    size_t queueDepth = 4;       // Blocks/batches in flight per queue
+};
+
+// Reads a launch CSV with three kinds of stage running concurrently:
+//
+//   reader --SPSC--> parser worker x N --MPSC--> aggregator
+//
+// The reader hands whole blocks of lines to whichever worker has room, each
+// worker turns a block into a batch LaunchTable, and the aggregator (the
+// calling thread) appends batches into the result. Every queue is bounded,
+// so a slow stage stalls the ones before it instead of growing memory.
+// Batches may be appended out of file order.
+class LaunchPipeline {
+    public:
+        explicit LaunchPipeline(const PipelineOptions& options = PipelineOptions());
+
+        // Loads path (skipping its header row) into table. Returns false if
+        // the file cannot be opened.
+        bool Run(const string& path, LaunchTable& table);
+
+        uint64_t SkippedRows() const { return skippedRows.load(); }
+
+        const StageStats& ReaderStats() const { return readerStats; }
+        const StageStats& ParserStats() const { return parserStats; }
+        const StageStats& AggregatorStats() const { return aggregatorStats; }
+
+        string StatsToString() const;
+
+    private:
+        struct Block {
+            string text;       // Complete lines only
+            bool last = false; // End-of-input marker
+        };
+
+        struct Batch {
+            LaunchTable rows;
+            uint64_t skipped = 0;
+            bool last = false;
+        };
+
+        void Dispatch(vector<unique_ptr<SpscRing<unique_ptr<Block> > > >& inputs, unique_ptr<Block>& block);
+        void ReadStage(const string& path, vector<unique_ptr<SpscRing<unique_ptr<Block> > > >& inputs);
+        void ParseStage(SpscRing<unique_ptr<Block> >& input, MpscRing<unique_ptr<Batch> >& output);
+
+        PipelineOptions options;
+        size_t nextWorker = 0;
+        atomic<uint64_t> skippedRows{0};
+        StageStats readerStats;
+        StageStats parserStats;
+        StageStats aggregatorStats;
+
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "LaunchQuery.h"
+#include <algorithm> // For nth_element
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+vector<string> split_query(const string &request) {
+    vector<string> words;
+    string word;
+    bool inside_quotes = false;
+    bool have_word = false;
+
+    for (char ch : request) {
+        if (ch == '"') {
+            inside_quotes = !inside_quotes;  // Quotes only group, they are not kept
+            have_word = true;
+        } else if ((ch == ' ' || ch == '\t' || ch == '\r') && !inside_quotes) {
+            if (have_word) {
+                words.push_back(word);
+                word.clear();
+                have_word = false;
+            }
+        } else {
+            word += ch;
+            have_word = true;
+        }
+    }
+
+    if (have_word) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+string join_query(const vector<string> &words) {
+    string request;
+    for (const string& word : words) {
+        if (!request.empty()) {
+            request += ' ';
+        }
+        size_t eq = word.find('=');
+        if (word.find(' ') != string::npos && eq != string::npos) {
+            request += word.substr(0, eq + 1) + "\"" + word.substr(eq + 1) + "\"";
+        } else if (word.find(' ') != string::npos) {
+            request += "\"" + word + "\"";
+        } else {
+            request += word;
+        }
+    }
+    return request;
+}
+
+static unsigned int days_in_month(int year, unsigned int month) {
+    static const unsigned int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+// Parses YYYY-MM-DD into days since the epoch. Rejects dates that don't
+// exist (2020-02-30) and anything after the day.
+static bool parse_iso_day(const string &text, int32_t &day) {
+    istringstream iss(text);
+    int year;
+    unsigned int month, mday;
+    char dash1, dash2;
+    if (!(iss >> year >> dash1 >> month >> dash2 >> mday) || dash1 != '-' || dash2 != '-' ||
+        iss.peek() != char_traits<char>::eof() ||
+        month < 1 || month > 12 || mday < 1 || mday > days_in_month(year, month)) {
+        return false;
+    }
+    day = days_from_civil(year, month, mday);
+    return true;
+}
+
+// Fills filter from the KEY=VALUE words starting at first. A name that is
+// not in the dictionary becomes NotFound, which matches no rows.
+static bool parse_filter(const LaunchTable &table, const vector<string> &words, size_t first,
+                         LaunchFilter &filter, string &error) {
+    for (size_t i = first; i < words.size(); i++) {
+        size_t eq = words[i].find('=');
+        if (eq == string::npos) {
+            error = "expected KEY=VALUE, got " + words[i];
+            return false;
+        }
+        string key = words[i].substr(0, eq);
+        string value = words[i].substr(eq + 1);
+
+        if (key == "company") {
+            filter.company = table.companies.Find(value);
+        } else if (key == "rocket") {
+            filter.rocketStatus = table.rocketStatuses.Find(value);
+        } else if (key == "mission") {
+            filter.missionStatus = table.missionStatuses.Find(value);
+        } else if (key == "from" || key == "to") {
+            int32_t day;
+            if (!parse_iso_day(value, day)) {
+                error = "bad date " + value + ", expected YYYY-MM-DD";
+                return false;
+            }
+            (key == "from" ? filter.fromDay : filter.toDay) = day;
+        } else {
+            error = "unknown key " + key;
+            return false;
+        }
+    }
+    return true;
+}
+
+string answer_query(const LaunchTable &table, const string &request) {
+    vector<string> words = split_query(request);
+    if (words.empty()) {
+        return "ERR empty request";
+    }
+
+    const string& command = words[0];
+    if (command == "PING") {
+        return "OK " + to_string(table.size());
+    }
+
+    size_t first_filter = 1;
+    double percentile = 0;
+    if (command == "PCT") {
+        char* end = nullptr;
+        if (words.size() < 2 || (percentile = strtod(words[1].c_str(), &end), *end != '\0') ||
+            !isfinite(percentile) || percentile < 0 || percentile > 100) {
+            return "ERR PCT needs a percentile from 0 to 100";
+        }
+        first_filter = 2;
+    } else if (command != "AVG" && command != "MIN" && command != "MAX" && command != "COUNT") {
+        return "ERR unknown command " + command;
+    }
+
+    LaunchFilter filter;
+    string error;
+    if (!parse_filter(table, words, first_filter, filter, error)) {
+        return "ERR " + error;
+    }
+
+    // COUNT and AVG only need the totals
+    if (command == "COUNT" || command == "AVG") {
+        size_t count;
+        long long unsigned int sum;
+        table.Summarize(filter, count, sum);
+        if (command == "COUNT") {
+            return "OK " + to_string(count);
+        }
+        if (count == 0) {
+            return "ERR no matching launches";
+        }
+        return "OK " + (TimeCode(0, 0, sum) / count).ToString() + " " + to_string(count);
+    }
+
+    // Matching times in seconds
+    vector<uint32_t> times;
+    for (size_t i = 0; i < table.size(); i++) {
+        if (table.Matches(i, filter)) {
+            times.push_back(static_cast<uint32_t>(table.GetTime(i).GetTimeCodeAsSeconds()));
+        }
+    }
+    if (times.empty()) {
+        return "ERR no matching launches";
+    }
+
+    TimeCode result;
+    if (command == "MIN") {
+        result = TimeCode(0, 0, *min_element(times.begin(), times.end()));
+    } else if (command == "MAX") {
+        result = TimeCode(0, 0, *max_element(times.begin(), times.end()));
+    } else {
+        // Nearest-rank percentile
+        size_t rank = static_cast<size_t>(ceil(percentile / 100 * times.size()));
+        size_t index = rank == 0 ? 0 : rank - 1;
+        if (index >= times.size()) {
+            index = times.size() - 1;
+        }
+        nth_element(times.begin(), times.begin() + index, times.end());
+        result = TimeCode(0, 0, times[index]);
+    }
+    return "OK " + result.ToString() + " " + to_string(times.size());
+}
@@ -0,0 +1,35 @@
+#ifndef LAUNCHQUERY_H
+#define LAUNCHQUERY_H
+
+#include <string>
+#include <vector>
+#include "LaunchData.h"
+
+using namespace std;
+
+// The launch query protocol: one request per line, one response per line.
+//
+//   request  := COMMAND [ARG] {KEY=VALUE}
+//   COMMAND  := AVG | MIN | MAX | PCT <0-100> | COUNT | PING
+//   KEY      := company | rocket | mission | from | to
+//
+// from/to are inclusive YYYY-MM-DD dates; values containing spaces are
+// written in double quotes (company="Rocket Lab").
+//
+//   response := OK <h:m:s> <matching rows>   for AVG, MIN, MAX, PCT
+//             | OK <matching rows>           for COUNT, and PING (all rows)
+//             | ERR <message>
+//
+// Example: "PCT 90 company=SpaceX from=2015-01-01" -> "OK 21:4:0 73"
+
+// Splits a request into words, keeping quoted values together.
+vector<string> split_query(const string &request);
+
+// Joins words back into a request, quoting any that need it.
+string join_query(const vector<string> &words);
+
+// Evaluates one request line against table and returns the response line
+// (without a trailing newline).
+string answer_query(const LaunchTable &table, const string &request);
+
+#endif
@@ -0,0 +1,191 @@
+#include "LaunchSampler.h"
+#include "LaunchData.h"
+#include "AllocProfile.h"
+#include <fstream>
+#include <random>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// Bytes read around each sampled offset; doubled when a row is longer.
+static const uint64_t kWindow = 4096;
+
+double normal_quantile(double confidence) {
+    // Bisection on erf(z / sqrt(2)) = confidence
+    double lo = 0.0, hi = 10.0;
+    for (int i = 0; i < 100; i++) {
+        double mid = (lo + hi) / 2;
+        if (erf(mid / sqrt(2.0)) < confidence) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo + hi) / 2;
+}
+
+/**
+ * Reads the row containing byte offset of file, without its newline.
+ * @param begin First byte of the data rows (just past the header).
+ * @param end File size.
+ */
+static string read_row_at(ifstream &file, uint64_t offset, uint64_t begin, uint64_t end) {
+    ALLOC_SCOPE("read_row_at");
+    for (uint64_t window = kWindow; ; window *= 2) {
+        uint64_t from = offset > begin + window ? offset - window : begin;
+        uint64_t to = offset + window < end ? offset + window : end;
+
+        vector<char> buffer(to - from);
+        file.clear();
+        file.seekg(from);
+        file.read(buffer.data(), buffer.size());
+        string text(buffer.data(), static_cast<size_t>(file.gcount()));
+
+        // The row starts after the last newline before offset...
+        size_t at = offset - from;
+        size_t start = at == 0 ? string::npos : text.rfind('\n', at - 1);
+        bool start_found = start != string::npos || from == begin;
+        start = start == string::npos ? 0 : start + 1;
+
+        // ...and ends at the first newline at or after it
+        size_t stop = text.find('\n', at);
+        bool stop_found = stop != string::npos || to == end;
+        stop = stop == string::npos ? text.size() : stop;
+
+        if (start_found && stop_found) {
+            return text.substr(start, stop - start);
+        }
+    }
+}
+
+LaunchSampler::LaunchSampler(const SampleOptions& options) : options(options) {
+    if (this->options.strata == 0) {
+        this->options.strata = 1;
+    }
+}
+
+bool LaunchSampler::Run(const string& path, SampleEstimate& estimate) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    string header;
+    getline(file, header);  // Skip header row
+    uint64_t begin = header.size() + 1;
+    file.seekg(0, ios::end);
+    uint64_t end = static_cast<uint64_t>(file.tellg());
+    if (begin >= end) {
+        return false;
+    }
+
+    mt19937_64 rng(options.seed != 0 ? options.seed : random_device()());
+    uint64_t span = end - begin;
+    const double z = normal_quantile(options.confidence);
+
+    // Running sums for the weighted mean and its variance
+    double sum_w = 0, sum_wx = 0, sum_wwxx = 0, sum_wwx = 0, sum_ww = 0;
+    double sum_w_all = 0;  // sum_w including rows without a valid time
+    size_t draws = 0;
+    estimate = SampleEstimate();
+
+    // z * standard error of the weighted mean (linearized ratio estimator)
+    auto half_width = [&]() {
+        double n = static_cast<double>(estimate.samples);
+        if (n < 2) {
+            return 0.0;
+        }
+        double mean = sum_wx / sum_w;
+        // sum w^2 (x - mean)^2, expanded so it can be kept as running sums
+        double ss = sum_wwxx - 2 * mean * sum_wwx + mean * mean * sum_ww;
+        return z * sqrt(max(ss, 0.0) * n / (n - 1)) / sum_w;
+    };
+
+    while (estimate.samples < options.maxSamples && draws < options.maxDraws) {
+        // Stratum draws % strata covers [lo, hi)
+        uint64_t stratum = draws % options.strata;
+        uint64_t lo = begin + span * stratum / options.strata;
+        uint64_t hi = begin + span * (stratum + 1) / options.strata;
+        draws++;
+        if (hi > lo) {
+            uint64_t offset = lo + rng() % (hi - lo);
+            string row = read_row_at(file, offset, begin, end);
+            double w = 1.0 / (row.size() + 1);  // Chance of landing in this row is proportional to its bytes
+            sum_w_all += w;
+
+            TimeCode time = parse_line(row);
+            if (is_valid_time(time)) {
+                double x = static_cast<double>(time.GetTimeCodeAsSeconds());
+                sum_w += w;
+                sum_wx += w * x;
+                sum_ww += w * w;
+                sum_wwx += w * w * x;
+                sum_wwxx += w * w * x * x;
+                estimate.samples++;
+            } else {
+                estimate.skipped++;  // Same rule as the exact analysis
+            }
+        }
+
+        // The stopping rules are checked on every iteration, valid draw or
+        // not, but only fire after a full pass over the strata
+        if (draws % options.strata != 0 || draws < options.minSamples) {
+            continue;
+        }
+        // Over byte-uniform draws E[w] = rows / bytes. Past that many draws
+        // most rows have been read already, so read the rest too.
+        if (static_cast<double>(draws) >= span * sum_w_all / draws) {
+            return RunExact(file, begin, estimate);
+        }
+        if (estimate.samples >= options.minSamples && half_width() <= options.targetError) {
+            estimate.converged = true;
+            break;
+        }
+    }
+
+    if (estimate.samples == 0) {
+        return false;
+    }
+
+    estimate.averageSeconds = sum_wx / sum_w;
+    estimate.halfWidthSeconds = half_width();
+    estimate.average = TimeCode(0, 0, static_cast<long long unsigned int>(llround(estimate.averageSeconds)));
+    // Over byte-uniform draws E[w * valid] = valid rows / bytes
+    estimate.estimatedRows = span * sum_w / (estimate.samples + estimate.skipped);
+    return true;
+}
+
+/**
+ * Averages every row of file from begin on, filling estimate with the exact
+ * result (a zero-width interval).
+ * @return False if no row has a valid launch time.
+ */
+bool LaunchSampler::RunExact(ifstream &file, uint64_t begin, SampleEstimate& estimate) {
+    estimate = SampleEstimate();
+    file.clear();
+    file.seekg(begin);
+
+    long long unsigned int sum = 0;
+    string line;
+    while (getline(file, line)) {
+        TimeCode time = parse_line(line);
+        if (!is_valid_time(time)) {
+            estimate.skipped++;
+            continue;
+        }
+        sum += time.GetTimeCodeAsSeconds();
+        estimate.samples++;
+    }
+
+    if (estimate.samples == 0) {
+        return false;
+    }
+
+    estimate.averageSeconds = static_cast<double>(sum) / estimate.samples;
+    estimate.average = TimeCode(0, 0, sum) / estimate.samples;
+    estimate.estimatedRows = estimate.samples;
+    estimate.converged = true;
+    estimate.exact = true;
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef LAUNCHSAMPLER_H
+#define LAUNCHSAMPLER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "TimeCode.h"
+
+using namespace std;
+
+struct SampleOptions {
+    double targetError = 300.0;  // Stop once the CI half-width is this many seconds or less
+    double confidence = 0.95;    // Two-sided confidence level of the interval
+    size_t minSamples = 100;     // Don't trust the variance estimate before this
+    size_t maxSamples = 1000000; // Give up on targetError after this many valid rows
+    size_t maxDraws = 2000000;   // ...or after this many draws, valid or not
+    unsigned int strata = 64;    // Equal byte ranges sampled round-robin
+    uint64_t seed = 0;           // 0 = seed from random_device
+};
+
+struct SampleEstimate {
+    TimeCode average;            // Estimated average launch time
+    double averageSeconds = 0;   // Same, unrounded
+    double halfWidthSeconds = 0; // average +/- this is the confidence interval
+    size_t samples = 0;          // Valid rows used
+    size_t skipped = 0;          // Sampled rows without a valid launch time
+    double estimatedRows = 0;    // Estimated number of data rows in the file
+    bool converged = false;      // Reached targetError before maxSamples
+    bool exact = false;          // Read every row instead (the file was too small to sample)
+};
+
+// Estimates the average launch time of a CSV without reading all of it.
+//
+// Each draw seeks to a random byte offset (stratified across the file so the
+// whole range is covered evenly), takes the row that contains that byte and
+// parses just that row. A byte offset picks long rows more often than short
+// ones, so every row is weighted by 1/length; the weighted (ratio) mean is
+// unbiased for the per-row average and its linearized variance gives the
+// confidence interval.
+//
+// Once the draws outnumber the estimated rows in the file, sampling costs
+// more than reading it, so Run falls back to an exact pass.
+class LaunchSampler {
+    public:
+        explicit LaunchSampler(const SampleOptions& options = SampleOptions());
+
+        // Returns false if path cannot be opened or has no valid data rows.
+        bool Run(const string& path, SampleEstimate& estimate);
+
+    private:
+        bool RunExact(ifstream& file, uint64_t begin, SampleEstimate& estimate);
+
+        SampleOptions options;
+
+};
+
+// z such that a standard normal lies within +/- z with the given probability.
+double normal_quantile(double confidence);
+
+#endif
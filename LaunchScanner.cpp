@@ -0,0 +1,201 @@
+#include "LaunchScanner.h"
+#include "AllocProfile.h"
+#include <algorithm>
+#include <fstream>
+#include <dirent.h>
+#include <glob.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+static bool has_csv_extension(const string &name) {
+    return name.size() > 4 && name.compare(name.size() - 4, 4, ".csv") == 0;
+}
+
+// Appends every *.csv under dir, in sorted order.
+static void walk_directory(const string &dir, vector<string> &files) {
+    DIR* handle = opendir(dir.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+    vector<string> entries;
+    while (dirent* entry = readdir(handle)) {
+        string name = entry->d_name;
+        if (name != "." && name != "..") {
+            entries.push_back(name);
+        }
+    }
+    closedir(handle);
+    sort(entries.begin(), entries.end());
+
+    for (const string& name : entries) {
+        string path = dir + "/" + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            walk_directory(path, files);
+        } else if (S_ISREG(st.st_mode) && has_csv_extension(name)) {
+            files.push_back(path);
+        }
+    }
+}
+
+// Adds one file or directory; returns false if path does not exist. With
+// csv_only (glob matches), files not named *.csv are left out, the same as
+// in a directory, so snapshots and other side files are never parsed.
+static bool add_path(const string &path, bool csv_only, vector<string> &files) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        walk_directory(path, files);
+    } else if (!csv_only || has_csv_extension(path)) {
+        files.push_back(path);
+    }
+    return true;
+}
+
+bool expand_launch_inputs(const vector<string> &inputs, vector<string> &files, string &error) {
+    for (const string& input : inputs) {
+        size_t before = files.size();
+        if (input.find_first_of("*?[") != string::npos) {
+            glob_t matches;
+            if (glob(input.c_str(), 0, nullptr, &matches) == 0) {
+                for (size_t i = 0; i < matches.gl_pathc; i++) {
+                    add_path(matches.gl_pathv[i], true, files);
+                }
+            }
+            globfree(&matches);
+        } else {
+            add_path(input, false, files);
+        }
+        if (files.size() == before) {
+            error = "No launch files found for " + input;
+            return false;
+        }
+    }
+    return true;
+}
+
+LaunchScanner::LaunchScanner(unsigned int threads, uint64_t chunkSize)
+    : pool(threads), chunkSize(chunkSize > 0 ? chunkSize : 1) {
+}
+
+void LaunchScanner::Fail(const string& message) {
+    lock_guard<mutex> lock(errorLock);
+    if (firstError.empty()) {
+        firstError = message;
+    }
+}
+
+// Splits a large file into chunk tasks on this worker's deque (other workers
+// steal them); a small file is scanned in place.
+void LaunchScanner::ScanFile(const string& path, size_t fileIndex) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        Fail("Error opening " + path);
+        return;
+    }
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+    if (size <= chunkSize) {
+        ScanChunk(path, fileIndex, 0, size);
+        return;
+    }
+    for (uint64_t begin = 0; begin < size; begin += chunkSize) {
+        uint64_t end = min(size, begin + chunkSize);
+        pool.Submit([this, path, fileIndex, begin, end] { ScanChunk(path, fileIndex, begin, end); });
+    }
+}
+
+// Parses every row that starts inside [begin, end). Row 0 (the header) is
+// skipped; a row that straddles begin belongs to the previous chunk.
+void LaunchScanner::ScanChunk(const string& path, size_t fileIndex, uint64_t begin, uint64_t end) {
+    ALLOC_SCOPE("LaunchScanner::ScanChunk");
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        Fail("Error opening " + path);
+        return;
+    }
+    chunks++;
+
+    // Only this worker touches its map, so no lock is needed
+    Partial& partial = partials[pool.CurrentWorker()][fileIndex];
+    string line;
+    uint64_t pos = begin;
+    if (begin == 0) {
+        getline(file, line);  // Skip header row
+        pos = static_cast<uint64_t>(line.size()) + 1;
+    } else {
+        // Unless begin is right after a newline, finish the previous chunk's row
+        file.seekg(begin - 1);
+        getline(file, line);
+        pos = begin - 1 + line.size() + 1;
+    }
+
+    while (pos < end && getline(file, line)) {
+        pos += line.size() + 1;
+        if (!partial.rows.AddLine(line)) {
+            partial.skipped++;  // Row has no valid launch time
+        }
+    }
+}
+
+// Runs every file on the pool, leaving the rows in partials.
+bool LaunchScanner::Scan(const vector<string>& files, string& error) {
+    partials.assign(pool.Size(), map<size_t, Partial>());
+    for (size_t i = 0; i < files.size(); i++) {
+        const string& path = files[i];
+        pool.Submit([this, path, i] { ScanFile(path, i); });
+    }
+    pool.Wait();
+
+    if (!firstError.empty()) {
+        error = firstError;
+        partials.clear();
+        return false;
+    }
+    return true;
+}
+
+bool LaunchScanner::Run(const vector<string>& files, LaunchTable& table, string& error) {
+    if (!Scan(files, error)) {
+        return false;
+    }
+
+    // Merge per-worker results; dictionaries are remapped by Append
+    for (map<size_t, Partial>& worker : partials) {
+        for (auto& entry : worker) {
+            table.Append(entry.second.rows);
+            skippedRows += entry.second.skipped;
+        }
+    }
+    partials.clear();
+    return true;
+}
+
+bool LaunchScanner::Run(const vector<string>& files, vector<LaunchTable>& tables, vector<uint64_t>& skipped,
+                        string& error) {
+    if (!Scan(files, error)) {
+        return false;
+    }
+
+    tables.assign(files.size(), LaunchTable());
+    skipped.assign(files.size(), 0);
+    for (map<size_t, Partial>& worker : partials) {
+        for (auto& entry : worker) {
+            size_t i = entry.first;
+            if (tables[i].size() == 0) {
+                tables[i] = move(entry.second.rows);  // First worker with rows for this file
+            } else {
+                tables[i].Append(entry.second.rows);
+            }
+            skipped[i] += entry.second.skipped;
+            skippedRows += entry.second.skipped;
+        }
+    }
+    partials.clear();
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef LAUNCHSCANNER_H
+#define LAUNCHSCANNER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "LaunchData.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+// Expands command-line inputs into launch CSV files. Each input may be a
+// file, a directory (searched recursively for *.csv), or a glob pattern.
+// Returns false and sets error if an input matches nothing.
+bool expand_launch_inputs(const vector<string> &inputs, vector<string> &files, string &error);
+
+// Loads many launch CSVs at once on a WorkStealingPool. Each file is one
+// task; a file larger than chunkSize splits itself into chunk tasks, which
+// idle workers steal, so one huge file does not leave other cores waiting.
+// Every worker parses each file it touches into its own LaunchTable and the
+// tables are merged at the end, either into one table or into one per file.
+class LaunchScanner {
+    public:
+        explicit LaunchScanner(unsigned int threads = 0, uint64_t chunkSize = 8 << 20);
+
+        // Loads every file (each with its own header row) into table.
+        // Returns false and sets error if a file cannot be read.
+        bool Run(const vector<string>& files, LaunchTable& table, string& error);
+
+        // Same, but keeps each file apart: tables[i] and skipped[i] are the
+        // rows and skipped-row count of files[i].
+        bool Run(const vector<string>& files, vector<LaunchTable>& tables, vector<uint64_t>& skipped,
+                 string& error);
+
+        uint64_t SkippedRows() const { return skippedRows; }
+        uint64_t Chunks() const { return chunks.load(); }
+        uint64_t Steals() const { return pool.Steals(); }
+        unsigned int Threads() const { return pool.Size(); }
+
+    private:
+        struct Partial {
+            LaunchTable rows;
+            uint64_t skipped = 0;
+        };
+
+        bool Scan(const vector<string>& files, string& error);
+        void ScanFile(const string& path, size_t fileIndex);
+        void ScanChunk(const string& path, size_t fileIndex, uint64_t begin, uint64_t end);
+        void Fail(const string& message);
+
+        WorkStealingPool pool;
+        uint64_t chunkSize;
+        vector<map<size_t, Partial> > partials;  // [worker][file], only files the worker touched
+        uint64_t skippedRows = 0;
+        atomic<uint64_t> chunks{0};
+
+        mutex errorLock;
+        string firstError;
+
+};
+
+#endif
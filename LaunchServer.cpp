@@ -0,0 +1,389 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <unistd.h>
+#include "LaunchData.h"
+#include "LaunchPipeline.h"
+#include "LaunchQuery.h"
+#include "LaunchSnapshot.h"
+
+using namespace std;
+
+// Resident launch-analytics server. Loads the CSV once, then answers
+// LaunchQuery.h requests over a Unix domain socket, reloading in the
+// background whenever the file's size or mtime changes.
+//
+// The main thread polls the listener and every idle connection. Complete
+// request lines are handed to a pool of threads one batch at a time, so an
+// idle client never ties up a pool thread. While a connection's batch is
+// being answered it is left out of the poll set, which keeps its responses
+// in request order.
+
+static atomic<bool> stopping(false);
+
+// Longest request line accepted; a client that sends more without a newline
+// is answered with ERR and disconnected.
+static const size_t kMaxRequest = 64 * 1024;
+
+// How long a response write may stall on a client that stopped reading.
+static const int kWriteTimeoutSeconds = 5;
+
+static void handle_signal(int) {
+    stopping = true;
+}
+
+// The table currently being served. Queries take a shared_ptr so a reload
+// can swap in a new table while old queries finish on the previous one.
+class TableHolder {
+    public:
+        shared_ptr<const LaunchTable> Get() {
+            lock_guard<mutex> lock(guard);
+            return table;
+        }
+
+        void Set(shared_ptr<const LaunchTable> next) {
+            lock_guard<mutex> lock(guard);
+            table = next;
+        }
+
+    private:
+        mutex guard;
+        shared_ptr<const LaunchTable> table;
+
+};
+
+// Requests read from one connection, answered together by a pool thread so
+// their responses go back in order.
+struct RequestBatch {
+    int fd = -1;
+    vector<string> requests;
+    bool tooLong = false;  // The connection sent an overlong line; close it after answering
+};
+
+// Batches waiting for a pool thread.
+class RequestQueue {
+    public:
+        void Push(RequestBatch& batch) {
+            lock_guard<mutex> lock(guard);
+            batches.push_back(move(batch));
+            ready.notify_one();
+        }
+
+        // Returns false once Close() has been called and the queue is drained.
+        bool Pop(RequestBatch& batch) {
+            unique_lock<mutex> lock(guard);
+            ready.wait(lock, [this] { return !batches.empty() || closed; });
+            if (batches.empty()) {
+                return false;
+            }
+            batch = move(batches.front());
+            batches.pop_front();
+            return true;
+        }
+
+        void Close() {
+            lock_guard<mutex> lock(guard);
+            closed = true;
+            ready.notify_all();
+        }
+
+    private:
+        mutex guard;
+        condition_variable ready;
+        deque<RequestBatch> batches;
+        bool closed = false;
+
+};
+
+// Connections whose batch a pool thread has finished, handed back to the
+// poll loop. A byte written to a pipe wakes the loop up.
+class FinishedQueue {
+    public:
+        FinishedQueue() {
+            if (pipe(wake) != 0) {
+                wake[0] = wake[1] = -1;
+            }
+        }
+
+        ~FinishedQueue() {
+            close(wake[0]);
+            close(wake[1]);
+        }
+
+        int WakeFd() const { return wake[0]; }
+
+        void Push(int fd, bool keep) {
+            {
+                lock_guard<mutex> lock(guard);
+                finished.push_back(make_pair(fd, keep));
+            }
+            char byte = 0;
+            ssize_t ignored = write(wake[1], &byte, 1);
+            (void)ignored;
+        }
+
+        // Returns every finished (fd, keep open) pair and drains the pipe.
+        vector<pair<int, bool> > Drain() {
+            char buffer[64];
+            ssize_t ignored = read(wake[0], buffer, sizeof(buffer));
+            (void)ignored;
+            lock_guard<mutex> lock(guard);
+            vector<pair<int, bool> > result;
+            result.swap(finished);
+            return result;
+        }
+
+    private:
+        mutex guard;
+        vector<pair<int, bool> > finished;
+        int wake[2];
+
+};
+
+// Loads from the binary snapshot when it matches, otherwise parses the CSV
+// and refreshes the snapshot.
+static shared_ptr<const LaunchTable> load_table(const string &path) {
+    shared_ptr<LaunchTable> table(new LaunchTable);
+    uint64_t skipped;
+    if (LaunchSnapshot::Load(path, *table, skipped)) {
+        return table;
+    }
+
+    FileStamp stamp;
+    stat_file(path, stamp);
+    LaunchPipeline pipeline;
+    if (!pipeline.Run(path, *table)) {
+        return nullptr;
+    }
+    LaunchSnapshot::Write(path, stamp, *table, pipeline.SkippedRows());
+    return table;
+}
+
+static bool write_all(int fd, const string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Answers one batch and writes the responses back.
+// @return False if the connection should be closed.
+static bool answer_batch(const RequestBatch &batch, TableHolder &holder) {
+    shared_ptr<const LaunchTable> table = holder.Get();
+    string responses;
+    for (const string& request : batch.requests) {
+        responses += answer_query(*table, request) + "\n";
+    }
+    if (batch.tooLong) {
+        responses += "ERR request longer than " + to_string(kMaxRequest) + " bytes\n";
+    }
+    return write_all(batch.fd, responses) && !batch.tooLong;
+}
+
+// Polls the file and swaps in a freshly loaded table when it changes.
+static void watch_file(const string &path, FileStamp stamp, chrono::milliseconds interval, TableHolder &holder) {
+    while (!stopping) {
+        this_thread::sleep_for(interval);
+        FileStamp now;
+        if (!stat_file(path, now) || !(now != stamp)) {
+            continue;
+        }
+        shared_ptr<const LaunchTable> table = load_table(path);
+        if (table) {
+            holder.Set(table);
+            stamp = now;
+            cerr << "Reloaded " << path << ": " << table->size() << " launches." << endl;
+        }
+    }
+}
+
+/**
+ * Options:
+ *   --file PATH      launch CSV to serve (default Space_Corrected.csv)
+ *   --socket PATH    Unix socket to listen on (default /tmp/nasa_launch.sock)
+ *   --threads N      requests answered at once (default 4)
+ *   --poll-ms N      how often to check the file for changes (default 1000)
+ */
+int main(int argc, char* argv[]) {
+    string path = "Space_Corrected.csv";
+    string socket_path = "/tmp/nasa_launch.sock";
+    unsigned int threads = 4;
+    long poll_ms = 1000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--file") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned int>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--poll-ms") == 0 && i + 1 < argc) {
+            poll_ms = atol(argv[++i]);
+        } else {
+            cout << "Usage: " << argv[0] << " [--file PATH] [--socket PATH] [--threads N] [--poll-ms N]" << endl;
+            return 1;
+        }
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    FileStamp stamp;
+    stat_file(path, stamp);
+    TableHolder holder;
+    shared_ptr<const LaunchTable> table = load_table(path);
+    if (!table) {
+        cout << "Error opening file!" << endl;
+        return 1;
+    }
+    holder.Set(table);
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        cout << "Socket path is too long!" << endl;
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path.c_str());  // Remove a stale socket from an earlier run
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listener, 64) != 0) {
+        cout << "Error listening on " << socket_path << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+    signal(SIGPIPE, SIG_IGN);  // A client hanging up mid-write is not fatal
+
+    RequestQueue requests;
+    FinishedQueue finished;
+    vector<thread> pool;
+    for (unsigned int i = 0; i < threads; i++) {
+        pool.emplace_back([&requests, &finished, &holder] {
+            RequestBatch batch;
+            while (requests.Pop(batch)) {
+                finished.Push(batch.fd, answer_batch(batch, holder));
+            }
+        });
+    }
+    thread watcher(watch_file, path, stamp, chrono::milliseconds(poll_ms), ref(holder));
+
+    cerr << "Serving " << table->size() << " launches on " << socket_path << endl;
+    table.reset();
+
+    // Unanswered bytes per open connection, and which of them a pool
+    // thread is answering right now
+    map<int, string> pending;
+    set<int> busy;
+    auto close_connection = [&pending](int fd) {
+        close(fd);
+        pending.erase(fd);
+    };
+
+    // Wake up periodically so a signal can stop the loop
+    vector<pollfd> pfds;
+    while (!stopping) {
+        pfds.clear();
+        pfds.push_back(pollfd{finished.WakeFd(), POLLIN, 0});
+        pfds.push_back(pollfd{listener, POLLIN, 0});
+        for (const auto& connection : pending) {
+            if (busy.count(connection.first) == 0) {
+                pfds.push_back(pollfd{connection.first, POLLIN, 0});
+            }
+        }
+        if (poll(pfds.data(), pfds.size(), 200) <= 0) {
+            continue;
+        }
+
+        if (pfds[0].revents != 0) {
+            for (const auto& done : finished.Drain()) {
+                busy.erase(done.first);
+                if (!done.second) {
+                    close_connection(done.first);
+                }
+            }
+        }
+
+        if (pfds[1].revents & POLLIN) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd >= 0) {
+                timeval timeout = {kWriteTimeoutSeconds, 0};
+                setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                pending[fd];
+            }
+        }
+
+        char buffer[4096];
+        for (size_t i = 2; i < pfds.size(); i++) {
+            if (pfds[i].revents == 0) {
+                continue;
+            }
+            int fd = pfds[i].fd;
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                close_connection(fd);
+                continue;
+            }
+            string& text = pending[fd];
+            text.append(buffer, static_cast<size_t>(n));
+
+            RequestBatch batch;
+            batch.fd = fd;
+            size_t start = 0, eol;
+            while ((eol = text.find('\n', start)) != string::npos) {
+                batch.requests.push_back(text.substr(start, eol - start));
+                start = eol + 1;
+            }
+            text.erase(0, start);
+            batch.tooLong = text.size() > kMaxRequest;
+            if (!batch.requests.empty() || batch.tooLong) {
+                busy.insert(fd);
+                requests.Push(batch);
+            }
+        }
+    }
+
+    // Queued batches are still answered; connections are closed after
+    requests.Close();
+    for (auto& t : pool) {
+        t.join();
+    }
+    watcher.join();
+    for (const auto& connection : pending) {
+        close(connection.first);
+    }
+    close(listener);
+    unlink(socket_path.c_str());
+    return 0;
+}
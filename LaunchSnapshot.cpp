@@ -0,0 +1,276 @@
+#include "LaunchSnapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const char kMagic[8] = {'N', 'L', 'A', 'S', 'N', 'A', 'P', '\0'};
+    const uint32_t kByteOrderMark = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        int64_t sourceSize;
+        int64_t sourceMtime;
+        int64_t sourceMtimeNsec;
+        uint64_t rows;
+        uint64_t skipped;
+        uint64_t payloadBytes;
+        uint64_t checksum;
+    };
+
+    size_t padded(size_t n) {
+        return (n + 7) & ~size_t(7);
+    }
+
+    // Hashes whole 64-bit words (the payload is always a multiple of 8 bytes).
+    uint64_t checksum64(const uint8_t* data, size_t bytes) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i + 8 <= bytes; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * 0x100000001b3ULL;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    // Builds the payload in memory, keeping each section 8-byte aligned.
+    class Writer {
+        public:
+            template <class T>
+            void Put(const T& value) { Bytes(&value, sizeof(T)); }
+
+            void Bytes(const void* data, size_t n) {
+                const uint8_t* p = static_cast<const uint8_t*>(data);
+                out.insert(out.end(), p, p + n);
+            }
+
+            void Align() { out.resize(padded(out.size()), 0); }
+
+            vector<uint8_t> out;
+    };
+
+    // Reads the mapped payload, failing instead of reading past the end.
+    class Reader {
+        public:
+            Reader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+            template <class T>
+            bool Get(T& value) { return Bytes(&value, sizeof(T)); }
+
+            bool Bytes(void* dest, size_t n) {
+                if (n > size - pos) {
+                    return false;
+                }
+                memcpy(dest, data + pos, n);
+                pos += n;
+                return true;
+            }
+
+            // Pointer to the next n bytes, which are then skipped.
+            const uint8_t* Take(size_t n) {
+                if (n > size - pos) {
+                    return nullptr;
+                }
+                const uint8_t* p = data + pos;
+                pos += n;
+                return p;
+            }
+
+            void Align() { pos = padded(pos) < size ? padded(pos) : size; }
+
+        private:
+            const uint8_t* data;
+            size_t size;
+            size_t pos = 0;
+    };
+
+    void write_dictionary(Writer& w, const StringDictionary& dictionary) {
+        w.Put(static_cast<uint32_t>(dictionary.size()));
+        for (uint32_t code = 0; code < dictionary.size(); code++) {
+            const string& value = dictionary.Lookup(code);
+            w.Put(static_cast<uint32_t>(value.size()));
+            w.Bytes(value.data(), value.size());
+        }
+        w.Align();
+    }
+
+    bool read_dictionary(Reader& r, StringDictionary& dictionary) {
+        uint32_t count;
+        if (!r.Get(count)) {
+            return false;
+        }
+        for (uint32_t code = 0; code < count; code++) {
+            uint32_t length;
+            const uint8_t* bytes;
+            if (!r.Get(length) || (bytes = r.Take(length)) == nullptr) {
+                return false;
+            }
+            // Codes are handed out in order, so they come back unchanged
+            if (dictionary.Intern(string(reinterpret_cast<const char*>(bytes), length)) != code) {
+                return false;
+            }
+        }
+        r.Align();
+        return true;
+    }
+
+    template <class T>
+    void write_column(Writer& w, const vector<T>& column) {
+        w.Bytes(column.data(), column.size() * sizeof(T));
+        w.Align();
+    }
+
+    template <class T>
+    bool read_column(Reader& r, vector<T>& column, uint64_t rows) {
+        column.resize(rows);
+        if (!r.Bytes(column.data(), rows * sizeof(T))) {
+            return false;
+        }
+        r.Align();
+        return true;
+    }
+
+    // Every code must index its dictionary.
+    bool codes_valid(const vector<uint32_t>& column, const StringDictionary& dictionary) {
+        for (uint32_t code : column) {
+            if (code >= dictionary.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool stat_file(const string &path, FileStamp &stamp) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    stamp.size = st.st_size;
+    stamp.mtime = st.st_mtime;
+#ifdef __APPLE__
+    stamp.mtimeNsec = st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtimeNsec = st.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+bool LaunchSnapshot::Write(const string &csvPath, const FileStamp &source, const LaunchTable &table,
+                           uint64_t skippedRows) {
+    Writer w;
+    write_dictionary(w, table.companies);
+    write_dictionary(w, table.rocketStatuses);
+    write_dictionary(w, table.missionStatuses);
+    w.Put(static_cast<uint64_t>(table.times.Words().size()));
+    write_column(w, table.times.Words());
+    write_column(w, table.day);
+    write_column(w, table.company);
+    write_column(w, table.rocketStatus);
+    write_column(w, table.missionStatus);
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = Version;
+    header.byteOrder = kByteOrderMark;
+    header.sourceSize = source.size;
+    header.sourceMtime = source.mtime;
+    header.sourceMtimeNsec = source.mtimeNsec;
+    header.rows = table.size();
+    header.skipped = skippedRows;
+    header.payloadBytes = w.out.size();
+    header.checksum = checksum64(w.out.data(), w.out.size());
+
+    string path = PathFor(csvPath);
+    string temp = path + ".tmp" + to_string(getpid());
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (w.out.empty() || fwrite(w.out.data(), w.out.size(), 1, file) == 1);
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp.c_str(), path.c_str()) != 0) {
+        remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LaunchSnapshot::Load(const string &csvPath, LaunchTable &table, uint64_t &skippedRows) {
+    FileStamp source;
+    if (!stat_file(csvPath, source)) {
+        return false;
+    }
+
+    int fd = open(PathFor(csvPath).c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(mapped);
+
+    Header header;
+    memcpy(&header, data, sizeof(header));
+    const uint8_t* payload = data + sizeof(header);
+    bool ok = memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+              header.version == Version &&
+              header.byteOrder == kByteOrderMark &&
+              header.sourceSize == source.size &&
+              header.sourceMtime == source.mtime &&
+              header.sourceMtimeNsec == source.mtimeNsec &&
+              header.payloadBytes == size - sizeof(header) &&
+              header.rows <= header.payloadBytes &&
+              checksum64(payload, header.payloadBytes) == header.checksum;
+
+    LaunchTable loaded;
+    if (ok) {
+        Reader r(payload, header.payloadBytes);
+        uint64_t wordCount = 0;
+        vector<uint64_t> words;
+        ok = read_dictionary(r, loaded.companies) &&
+             read_dictionary(r, loaded.rocketStatuses) &&
+             read_dictionary(r, loaded.missionStatuses) &&
+             r.Get(wordCount) &&
+             wordCount == (header.rows * TimeOfDay::Bits + 63) / 64 &&
+             read_column(r, words, wordCount) &&
+             read_column(r, loaded.day, header.rows) &&
+             read_column(r, loaded.company, header.rows) &&
+             read_column(r, loaded.rocketStatus, header.rows) &&
+             read_column(r, loaded.missionStatus, header.rows) &&
+             codes_valid(loaded.company, loaded.companies) &&
+             codes_valid(loaded.rocketStatus, loaded.rocketStatuses) &&
+             codes_valid(loaded.missionStatus, loaded.missionStatuses);
+        if (ok) {
+            loaded.times.AssignWords(words.data(), words.size(), header.rows);
+        }
+    }
+    munmap(mapped, size);
+
+    if (!ok) {
+        return false;
+    }
+    table = move(loaded);
+    skippedRows = header.skipped;
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef LAUNCHSNAPSHOT_H
+#define LAUNCHSNAPSHOT_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include "LaunchData.h"
+
+using namespace std;
+
+// Size and modification time of a file, used to tell whether a snapshot
+// still matches the CSV it was built from.
+struct FileStamp {
+    int64_t size = -1;
+    int64_t mtime = 0;
+    int64_t mtimeNsec = 0;
+
+    bool operator==(const FileStamp& other) const {
+        return size == other.size && mtime == other.mtime && mtimeNsec == other.mtimeNsec;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+bool stat_file(const string &path, FileStamp &stamp);
+
+// Binary copy of a parsed launch CSV kept next to it as "<csv>.snap", so
+// later runs map the parsed columns straight into memory instead of parsing
+// text.
+//
+// Layout (native byte order, every section 8-byte aligned):
+//   header   magic "NLASNAP", version, byte-order mark, the source's
+//            FileStamp, row and skipped-row counts, payload size and a
+//            64-bit checksum of the payload
+//   payload  the three dictionaries (count, then length + bytes per
+//            string), the packed time-of-day words, then the day, company,
+//            rocket status and mission status columns
+//
+// Load rejects a snapshot whose version, byte order, source stamp, size or
+// checksum does not match; the caller then re-parses and rewrites it.
+class LaunchSnapshot {
+    public:
+        static const uint32_t Version = 1;
+
+        static string PathFor(const string &csvPath) { return csvPath + ".snap"; }
+
+        // Loads the snapshot for csvPath into table (which should be empty).
+        // Returns false if there is none or it is stale or corrupt.
+        static bool Load(const string &csvPath, LaunchTable &table, uint64_t &skippedRows);
+
+        // Writes the snapshot for csvPath, stamped with source (the
+        // FileStamp taken before csvPath was parsed). Writes to a temporary
+        // file and renames it, so readers never see half a snapshot.
+        static bool Write(const string &csvPath, const FileStamp &source, const LaunchTable &table,
+                          uint64_t skippedRows);
+
+};
+
+#endif
@@ -3,124 +3,312 @@
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm> // For sort
 #include "TimeCode.h"
+#include "TimeOfDay.h"
+#include "LaunchData.h"
+#include "LaunchPipeline.h"
+#include "LaunchSampler.h"
+#include "LaunchScanner.h"
+#include "LaunchSnapshot.h"
 
 using namespace std;
 
 /**
- * Splits a CSV line into fields, handling quoted values correctly.
- * @param line The CSV line to split.
- * @return A vector of parsed fields.
+ * Prints the launch count and average launch time for each company, in
+ * company name order.
+ * @param table The parsed launch rows.
  */
-vector<string> split_csv(const string &line) {
-    vector<string> result;
-    string field;
-    bool inside_quotes = false;
-
-    for (char ch : line) {
-        if (ch == '"') {
-            inside_quotes = !inside_quotes;  // Toggle quote tracking
-        } else if (ch == ',' && !inside_quotes) {
-            result.push_back(field);  // Add the completed field to the result vector
-            field.clear();  // Reset field for the next entry
-        } else {
-            field += ch;  // Append character to the current field
-        }
+void print_by_company(const LaunchTable &table) {
+    vector<size_t> counts;
+    vector<long long unsigned int> sums;
+    table.GroupByCompany(counts, sums);
+
+    // Codes depend on which worker saw a company first, so sort by name
+    vector<uint32_t> codes(counts.size());
+    for (uint32_t code = 0; code < codes.size(); code++) {
+        codes[code] = code;
     }
+    sort(codes.begin(), codes.end(), [&table](uint32_t a, uint32_t b) {
+        return table.companies.Lookup(a) < table.companies.Lookup(b);
+    });
 
-    result.push_back(field);  // Add last field
-    return result;
+    for (uint32_t code : codes) {
+        TimeCode avg = TimeCode(0, 0, sums[code]) / counts[code];
+        cout << table.companies.Lookup(code) << ": " << counts[code]
+             << " launches, AVERAGE: " << avg.ToString() << endl;
+    }
 }
 
 /**
- * Extracts and parses the time (HH:MM) from the "Datum" column.
- * @param line The CSV line containing the timestamp.
- * @return A TimeCode object representing the extracted time.
+ * Estimates the average launch time from a sample of rows and prints it
+ * with its confidence interval.
+ * @return The exit code for main.
  */
-TimeCode parse_line(const string &line) {
-    vector<string> fields = split_csv(line);
+int run_approximate(const string &path, const SampleOptions &options) {
+    LaunchSampler sampler(options);
+    SampleEstimate estimate;
+    if (!sampler.Run(path, estimate)) {
+        cout << "Error opening file or no data rows!" << endl;
+        return 1;
+    }
+    if (estimate.exact) {
+        cout << estimate.samples << " data points (file too small to sample, read all of it)." << endl;
+        cout << "AVERAGE: " << estimate.average.ToString() << endl;
+        return 0;
+    }
+
+    cout << estimate.samples << " data points sampled (of about "
+         << static_cast<long long unsigned int>(llround(estimate.estimatedRows)) << ")." << endl;
+    cout << "AVERAGE: " << estimate.average.ToString() << " +/- "
+         << TimeCode(0, 0, static_cast<long long unsigned int>(ceil(estimate.halfWidthSeconds))).ToString()
+         << " (" << options.confidence * 100 << "% confidence"
+         << (estimate.converged ? "" : ", target error not reached") << ")" << endl;
+    return 0;
+}
 
-    // Ensure we have enough columns to extract a valid time
-    if (fields.size() <= 3) {
-        return TimeCode(-1, -1, -1);  // Return an invalid marker
+/**
+ * Streams each file through the reader/parser/aggregator pipeline, one
+ * file after another.
+ * @return False if a file cannot be opened.
+ */
+bool load_with_pipeline(const vector<string> &files, const PipelineOptions &options,
+                        bool show_stats, LaunchTable &launches, uint64_t &skipped_rows) {
+    for (const string& path : files) {
+        LaunchPipeline pipeline(options);
+        if (!pipeline.Run(path, launches)) {
+            cout << "Error opening " << path << "!" << endl;
+            return false;
+        }
+        skipped_rows += pipeline.SkippedRows();
+        if (show_stats) {
+            cout << path << ":" << endl << pipeline.StatsToString();
+        }
     }
+    return true;
+}
 
-    string datum = fields[3];  // Extract the "Datum" column
-    
-    // Locate the UTC position in the string
-    size_t utc_pos = datum.rfind(" UTC");
-    if (utc_pos == string::npos) {
-        return TimeCode(-1, -1, -1);  // Return invalid if "UTC" is not found
+/**
+ * Loads all files at once on a work-stealing pool, splitting big files
+ * into chunks.
+ * @return False if a file cannot be read.
+ */
+bool load_with_scanner(const vector<string> &files, unsigned int threads, uint64_t chunk_size,
+                       bool show_stats, LaunchTable &launches, uint64_t &skipped_rows) {
+    LaunchScanner scanner(threads, chunk_size);
+    string error;
+    if (!scanner.Run(files, launches, error)) {
+        cout << error << "!" << endl;
+        return false;
+    }
+    skipped_rows += scanner.SkippedRows();
+    if (show_stats) {
+        cout << files.size() << " files, " << scanner.Chunks() << " chunks, "
+             << scanner.Steals() << " steals (" << scanner.Threads() << " threads)" << endl;
     }
+    return true;
+}
 
-    // Find the space before the time portion
-    size_t time_start = datum.rfind(" ", utc_pos - 1);
-    if (time_start == string::npos) {
-        return TimeCode(-1, -1, -1);
+/**
+ * Adds part to launches, moving it in whole when launches is still empty.
+ */
+void merge_table(LaunchTable &launches, LaunchTable &part) {
+    if (launches.size() == 0) {
+        launches = move(part);
+    } else {
+        launches.Append(part);
     }
+}
 
-    string time_part = datum.substr(time_start + 1, utc_pos - time_start - 1);
+/**
+ * Loads each file from its binary snapshot when one matches. The rest are
+ * parsed together (one scanner run, so big and small files share the
+ * workers) and get a fresh snapshot each.
+ * @return False if a file cannot be read.
+ */
+bool load_with_snapshots(const vector<string> &files, bool use_pipeline, const PipelineOptions &options,
+                         uint64_t chunk_size, bool show_stats, LaunchTable &launches, uint64_t &skipped_rows) {
+    vector<LaunchTable> parts(files.size());
+    vector<uint64_t> part_skipped(files.size(), 0);
+    vector<string> missed;
+    vector<size_t> missed_index;
+    vector<FileStamp> stamps;
+    size_t rebuilt = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!LaunchSnapshot::Load(files[i], parts[i], part_skipped[i])) {
+            FileStamp stamp;  // Taken first, so edits during the parse leave the snapshot stale
+            stat_file(files[i], stamp);
+            missed.push_back(files[i]);
+            missed_index.push_back(i);
+            stamps.push_back(stamp);
+        }
+    }
 
-    // Validate and extract hours/minutes
-    istringstream iss(time_part);
-    unsigned int hours, minutes;
-    char sep;
-    if (!(iss >> hours >> sep >> minutes) || sep != ':') {
-        return TimeCode(-1, -1, -1);  // Return invalid if parsing fails
+    if (!missed.empty()) {
+        vector<LaunchTable> parsed(missed.size());
+        vector<uint64_t> parsed_skipped(missed.size(), 0);
+        if (use_pipeline) {
+            for (size_t m = 0; m < missed.size(); m++) {
+                if (!load_with_pipeline(vector<string>(1, missed[m]), options, show_stats,
+                                        parsed[m], parsed_skipped[m])) {
+                    return false;
+                }
+            }
+        } else {
+            LaunchScanner scanner(options.workers, chunk_size);
+            string error;
+            if (!scanner.Run(missed, parsed, parsed_skipped, error)) {
+                cout << error << "!" << endl;
+                return false;
+            }
+            if (show_stats) {
+                cout << missed.size() << " files, " << scanner.Chunks() << " chunks, "
+                     << scanner.Steals() << " steals (" << scanner.Threads() << " threads)" << endl;
+            }
+        }
+        for (size_t m = 0; m < missed.size(); m++) {
+            if (LaunchSnapshot::Write(missed[m], stamps[m], parsed[m], parsed_skipped[m])) {
+                rebuilt++;
+            }
+            parts[missed_index[m]] = move(parsed[m]);
+            part_skipped[missed_index[m]] = parsed_skipped[m];
+        }
     }
 
-    return TimeCode(hours, minutes, 0);
+    for (size_t i = 0; i < files.size(); i++) {
+        merge_table(launches, parts[i]);
+        skipped_rows += part_skipped[i];
+    }
+    if (show_stats) {
+        cout << files.size() - missed.size() << " snapshots loaded, " << rebuilt << " rebuilt." << endl;
+    }
+    return true;
 }
 
 /**
- * Main function that reads a CSV file, extracts launch times, 
+ * Main function that reads launch CSV files, extracts launch times, 
  * calculates the average time, and outputs the results.
+ * Usage: nasa [options] [FILE|DIR|GLOB ...]   (default Space_Corrected.csv)
+ * Directories are searched recursively for *.csv files.
+ * Options:
+ *   --by-company        also print the average per company
+ *   --threads N         worker threads (default: one per core)
+ *   --chunk-size BYTES  split files larger than this across workers (default 8 MiB)
+ *   --pipeline          stream files one at a time through the staged pipeline instead
+ *   --block-size BYTES  with --pipeline, read size handed to each parser (default 1 MiB)
+ *   --stats             print scheduler or per-stage pipeline counters
+ *   --no-snapshot       always parse the CSV text; don't read or write FILE.snap
+ *   --approx            estimate the average from a random sample of rows (one file only)
+ *   --target-error SEC  with --approx, stop once the interval is +/- SEC (default 300)
+ *   --confidence P      with --approx, confidence level (default 0.95)
+ *   --seed N            with --approx, seed for repeatable samples
  */
-int main() {
-    ifstream file("Space_Corrected.csv");
-    if (!file.is_open()) {
-        cout << "Error opening file!" << endl;
-        return 1;
+int main(int argc, char* argv[]) {
+    bool by_company = false;
+    bool show_stats = false;
+    bool use_pipeline = false;
+    bool use_snapshot = true;
+    PipelineOptions options;
+    uint64_t chunk_size = 8 << 20;
+    bool approximate = false;
+    SampleOptions sample_options;
+    vector<string> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--by-company") == 0) {
+            by_company = true;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            show_stats = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.workers = static_cast<unsigned int>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--chunk-size") == 0 && i + 1 < argc) {
+            chunk_size = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            use_pipeline = true;
+        } else if (strcmp(argv[i], "--no-snapshot") == 0) {
+            use_snapshot = false;
+        } else if (strcmp(argv[i], "--block-size") == 0 && i + 1 < argc) {
+            options.blockSize = static_cast<size_t>(atoll(argv[++i]));
+        } else if (strcmp(argv[i], "--approx") == 0) {
+            approximate = true;
+        } else if (strcmp(argv[i], "--target-error") == 0 && i + 1 < argc) {
+            sample_options.targetError = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--confidence") == 0 && i + 1 < argc) {
+            sample_options.confidence = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            sample_options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (argv[i][0] != '-') {
+            inputs.push_back(argv[i]);
+        } else {
+            cout << "Usage: " << argv[0] << " [--by-company] [--threads N] [--chunk-size BYTES]"
+                 << " [--pipeline [--block-size BYTES]] [--no-snapshot] [--stats]"
+                 << " [--approx [--target-error SEC] [--confidence P] [--seed N]] [FILE|DIR|GLOB ...]" << endl;
+            return 1;
+        }
     }
 
-    vector<TimeCode> launch_times;
-    string line;
-    int skipped_rows = 0;  // Counter for skipped rows
-
-    getline(file, line);  // Skip header row
+    if (inputs.empty()) {
+        inputs.push_back("Space_Corrected.csv");
+    }
+    vector<string> files;
+    string error;
+    if (!expand_launch_inputs(inputs, files, error)) {
+        cout << error << "!" << endl;
+        return 1;
+    }
 
-    while (getline(file, line)) {
-        TimeCode time = parse_line(line);
-        
-        // Validate extracted time values before adding to vector
-        if (time.GetHours() >= 0 && time.GetHours() < 24 && time.GetMinutes() < 60) { 
-            launch_times.push_back(time);
-        } else {
-            skipped_rows++;  // Increment count if row is skipped due to invalid time
+    if (approximate) {
+        if (files.size() != 1) {
+            cout << "--approx takes a single file." << endl;
+            return 1;
         }
+        if (sample_options.confidence <= 0 || sample_options.confidence >= 1) {
+            cout << "Confidence must be between 0 and 1." << endl;
+            return 1;
+        }
+        return run_approximate(files[0], sample_options);
+    }
+
+    LaunchTable launches;  // Company and status columns stored as dictionary codes
+    uint64_t skipped_rows = 0;  // Counter for skipped rows across all files
+    bool loaded;
+    if (use_snapshot) {
+        loaded = load_with_snapshots(files, use_pipeline, options, chunk_size, show_stats, launches, skipped_rows);
+    } else if (use_pipeline) {
+        loaded = load_with_pipeline(files, options, show_stats, launches, skipped_rows);
+    } else {
+        loaded = load_with_scanner(files, options.workers, chunk_size, show_stats, launches, skipped_rows);
+    }
+    if (!loaded) {
+        return 1;
     }
 
-    file.close();
+    if (show_stats) {
+        cout << skipped_rows << " rows skipped." << endl;
+    }
 
     // Ensure we have valid data before proceeding
-    if (launch_times.empty()) {
+    if (launches.size() == 0) {
         cout << "No valid time data found." << endl;
         return 1;
     }
 
     // Compute the average time
-    TimeCode sum_time;
-    for (const auto &time : launch_times) {
-        sum_time = sum_time + time;  // Accumulate total time
-    }
+    TimeCode sum_time(0, 0, launches.SumSeconds());  // Accumulate total time
 
-    TimeCode avg_time = sum_time / static_cast<double>(launch_times.size());
+    TimeCode avg_time = sum_time / launches.size();  // Exact integer division
 
     // Display results
-    cout << launch_times.size() << " data points." << endl;
+    cout << launches.size() << " data points." << endl;
     cout << "AVERAGE: " << avg_time.ToString() << endl;
 
+    if (by_company) {
+        print_by_company(launches);
+    }
+
     return 0;
 }
 
-// I read the three notes at the top!!
\ No newline at end of file
+// I read the three notes at the top!!
@@ -5,6 +5,7 @@
 #include <cstdlib>     // For rand()
 #include <cassert>     // For testing
 #include "TimeCode.h"  // TimeCode class
+#include "AllocProfile.h"  // ALLOC_SCOPE tags (no-op unless built with -DALLOC_PROFILE)
 
 using namespace std;
 
@@ -30,6 +31,7 @@ double get_sphere_sa(double radius) {
 // Function to compute drying time based on surface area
 // Uses total surface area as seconds to dry (as an arbitrary mapping)
 TimeCode* compute_time_code(double surfaceArea) {
+    ALLOC_SCOPE("compute_time_code");
     return new TimeCode(0, 0, static_cast<unsigned long long>(surfaceArea)); // Allocate dynamically
 }
 
@@ -0,0 +1,138 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>  // For the lock-free head/tail indexes
+#include <cstddef>
+#include <vector>
+#include <utility> // For move
+
+using namespace std;
+
+// Rounds n up to a power of two so slot indexes can be masked instead of
+// taking a modulus.
+inline size_t ring_capacity(size_t n) {
+    size_t capacity = 2;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// An index padded out to its own cache line so the producer's and the
+// consumer's writes don't invalidate each other.
+struct RingIndex {
+    atomic<size_t> value{0};
+    char padding[64 - sizeof(atomic<size_t>)];
+};
+
+// Bounded single-producer/single-consumer queue. TryPush and TryPop never
+// block; they return false when the ring is full or empty so the caller can
+// decide how to wait (that is where backpressure comes from).
+template <class T>
+class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity)
+            : slots(ring_capacity(capacity)), mask(slots.size() - 1) {}
+
+        bool TryPush(T& value) {
+            size_t tail = tailIndex.value.load(memory_order_relaxed);
+            if (tail - headIndex.value.load(memory_order_acquire) == slots.size()) {
+                return false;  // Full
+            }
+            slots[tail & mask] = move(value);
+            tailIndex.value.store(tail + 1, memory_order_release);
+            return true;
+        }
+
+        bool TryPop(T& value) {
+            size_t head = headIndex.value.load(memory_order_relaxed);
+            if (head == tailIndex.value.load(memory_order_acquire)) {
+                return false;  // Empty
+            }
+            value = move(slots[head & mask]);
+            headIndex.value.store(head + 1, memory_order_release);
+            return true;
+        }
+
+        // Approximate number of queued items; exact only when both sides are idle.
+        size_t Size() const {
+            return tailIndex.value.load(memory_order_acquire) - headIndex.value.load(memory_order_acquire);
+        }
+
+        size_t Capacity() const { return slots.size(); }
+
+    private:
+        vector<T> slots;
+        const size_t mask;
+        RingIndex headIndex;  // Next slot to pop (consumer)
+        RingIndex tailIndex;  // Next slot to push (producer)
+
+};
+
+// Bounded multi-producer/single-consumer queue. Each slot carries a sequence
+// number that tells producers whether it is free for lap N and the consumer
+// whether it has been filled (Vyukov's bounded queue).
+template <class T>
+class MpscRing {
+    public:
+        explicit MpscRing(size_t capacity)
+            : cells(ring_capacity(capacity)), mask(cells.size() - 1) {
+            for (size_t i = 0; i < cells.size(); i++) {
+                cells[i].sequence.store(i, memory_order_relaxed);
+            }
+        }
+
+        bool TryPush(T& value) {
+            size_t pos = tailIndex.value.load(memory_order_relaxed);
+            while (true) {
+                Cell& cell = cells[pos & mask];
+                size_t seq = cell.sequence.load(memory_order_acquire);
+                if (seq == pos) {
+                    // Slot is free for this lap; claim it
+                    if (tailIndex.value.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                        cell.value = move(value);
+                        cell.sequence.store(pos + 1, memory_order_release);
+                        return true;
+                    }
+                } else if (seq < pos) {
+                    return false;  // Full: the consumer has not freed this slot yet
+                } else {
+                    pos = tailIndex.value.load(memory_order_relaxed);  // Another producer won
+                }
+            }
+        }
+
+        bool TryPop(T& value) {
+            size_t pos = headIndex.value.load(memory_order_relaxed);
+            Cell& cell = cells[pos & mask];
+            if (cell.sequence.load(memory_order_acquire) != pos + 1) {
+                return false;  // Empty, or a producer is still writing
+            }
+            value = move(cell.value);
+            cell.sequence.store(pos + cells.size(), memory_order_release);
+            headIndex.value.store(pos + 1, memory_order_relaxed);
+            return true;
+        }
+
+        size_t Size() const {
+            size_t tail = tailIndex.value.load(memory_order_acquire);
+            size_t head = headIndex.value.load(memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        size_t Capacity() const { return cells.size(); }
+
+    private:
+        struct Cell {
+            atomic<size_t> sequence{0};
+            T value;
+        };
+
+        vector<Cell> cells;
+        const size_t mask;
+        RingIndex headIndex;
+        RingIndex tailIndex;
+
+};
+
+#endif
@@ -1,24 +1,30 @@
 #include "TimeCode.h"
+#include "AllocProfile.h"
 #include <iomanip>  // For formatting output
 #include <stdexcept> // For handling exceptions
 #include <sstream>   // For string stream operations
+#include <limits>    // For overflow checks in Scale
+
+#ifndef __SIZEOF_INT128__
+#error "TimeCode::Scale needs a compiler with unsigned __int128 (GCC or Clang)"
+#endif
 
 using namespace std;
 
 // Constructor: Converts hours, minutes, and seconds into total seconds.
 // Ensures proper carryover when values exceed 59.
-TimeCode::TimeCode(unsigned int hr, unsigned int min, long long unsigned int sec) {
-    min += sec / 60;  // Carry over excess seconds into minutes
+TimeCode::BasicTimeCode(unsigned int hr, unsigned int min, long long unsigned int sec) {
+    // Carry in 64 bits so huge second counts don't wrap the 32-bit hr/min
+    long long unsigned int totalMin = min + sec / 60;  // Carry over excess seconds into minutes
     sec = sec % 60;   // Keep seconds within 0-59 range
-    hr += min / 60;   // Carry over excess minutes into hours
-    min = min % 60;   // Keep minutes within 0-59 range
+    long long unsigned int totalHr = hr + totalMin / 60;  // Carry over excess minutes into hours
+    totalMin = totalMin % 60;   // Keep minutes within 0-59 range
 
-    t = static_cast<long long unsigned int>(hr) * 3600 + 
-        static_cast<long long unsigned int>(min) * 60 + sec;
+    t = totalHr * 3600 + totalMin * 60 + sec;
 }
 
 // Copy Constructor: Creates a new TimeCode object with the same total seconds.
-TimeCode::TimeCode(const TimeCode& tc) {
+TimeCode::BasicTimeCode(const TimeCode& tc) {
     t = tc.t;
 }
 
@@ -91,6 +97,7 @@ unsigned int TimeCode::GetSeconds() const {
 
 // Converts the time into a human-readable string (e.g., "3:15:42").
 string TimeCode::ToString() const {
+    ALLOC_SCOPE("TimeCode::ToString");
     unsigned int hr, min, sec;
     GetComponents(hr, min, sec); // Extract time components
     
@@ -133,6 +140,36 @@ TimeCode TimeCode::operator/(double a) const {
     return TimeCode(0, 0, newSeconds);
 }
 
+// Scales the TimeCode by num/den using integer math only.
+TimeCode TimeCode::Scale(long long unsigned int num, long long unsigned int den, TimeCodeRounding mode) const {
+    return FromTicks(timecode_detail::ScaleTicks(t, num, den, mode));
+}
+
+// Computes ticks * num / den in 128 bits so neither the product nor the
+// quotient loses precision, then rounds the remainder as requested.
+long long unsigned int timecode_detail::ScaleTicks(long long unsigned int ticks, long long unsigned int num,
+                                                   long long unsigned int den, TimeCodeRounding mode) {
+    if (den == 0) {
+        throw invalid_argument("Cannot divide by 0!");
+    }
+    unsigned __int128 product = static_cast<unsigned __int128>(ticks) * num;
+    unsigned __int128 quotient = product / den;
+    unsigned __int128 remainder = product % den;
+
+    if (remainder != 0) {
+        if (mode == TimeCodeRounding::Up) {
+            quotient++;
+        } else if (mode == TimeCodeRounding::Nearest && remainder >= den - remainder) {
+            quotient++;  // Halves round up
+        }
+    }
+
+    if (quotient > numeric_limits<long long unsigned int>::max()) {
+        throw overflow_error("TimeCode scaling overflows!");
+    }
+    return static_cast<long long unsigned int>(quotient);
+}
+
 // Equality operator: Returns true if two TimeCode objects have the same total time.
 bool TimeCode::operator==(const TimeCode& other) const {
     return t == other.t;
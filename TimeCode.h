@@ -2,14 +2,78 @@
 #define TIMECODE_H
 
 #include <iostream> // use for the throw "Negative Condition" lines
+#include <chrono>      // For interop with std::chrono::duration
+#include <ratio>       // For compile-time resolutions (std::milli, std::micro, ...)
+#include <type_traits> // For enable_if on lossless conversions
+#include <limits>      // For overflow checks when converting resolutions
+#include <stdexcept>   // For invalid_argument / overflow_error
+#include <sstream>     // For ToString on the template
+#include <iomanip>     // For zero-padding the sub-second digits
 
 using namespace std;
 
-class TimeCode {
+// A time code whose smallest unit is Resolution (a std::ratio of a second).
+// TimeCode below is the whole-second instantiation; MilliTimeCode,
+// MicroTimeCode and NanoTimeCode are the sub-second ones.
+template <class Resolution>
+class BasicTimeCode;
+
+// How Scale() rounds a result that is not a whole number of ticks.
+// Nearest rounds halves up.
+enum class TimeCodeRounding { TowardZero, Nearest, Up };
+
+namespace timecode_detail {
+    // ticks * num / den computed exactly with a 128-bit intermediate.
+    // Throws invalid_argument when den is 0 and overflow_error when the
+    // result does not fit in 64 bits.
+    long long unsigned int ScaleTicks(long long unsigned int ticks, long long unsigned int num,
+                                      long long unsigned int den, TimeCodeRounding mode);
+
+    // ticks_in_To = ticks_in_From * Factor::num / Factor::den
+    template <class From, class To>
+    struct Conversion {
+        typedef ratio_divide<From, To> Factor;
+        static const bool exact = (Factor::den == 1);
+    };
+
+    // Converts a tick count between resolutions. Truncates when the target is
+    // coarser and throws overflow_error when the result does not fit.
+    template <class From, class To>
+    long long unsigned int ConvertTicks(long long unsigned int ticks) {
+        typedef typename Conversion<From, To>::Factor Factor;
+        const long long unsigned int num = Factor::num;
+        const long long unsigned int den = Factor::den;
+        const long long unsigned int whole = ticks / den;
+        const long long unsigned int rest = ticks % den;
+        if (num != 1 && whole > numeric_limits<long long unsigned int>::max() / num) {
+            throw overflow_error("TimeCode conversion overflows!");
+        }
+        // rest < den, so rest * num only overflows for exotic ratios
+        return whole * num + rest * num / den;
+    }
+}
+
+// Whole-second time code; the original TimeCode interface.
+template <>
+class BasicTimeCode<ratio<1> > {
     public:
-        TimeCode(unsigned int hr = 0, unsigned int min = 0, long long unsigned int sec = 0);
-        TimeCode(const TimeCode& tc);
-        ~TimeCode(){};
+        typedef ratio<1> resolution;
+
+        BasicTimeCode(unsigned int hr = 0, unsigned int min = 0, long long unsigned int sec = 0);
+        BasicTimeCode(const BasicTimeCode& tc);
+        ~BasicTimeCode(){};
+
+        // Implicit only from integral whole-second multiples (seconds, minutes,
+        // hours); floating-point durations need an explicit duration_cast.
+        template <class Rep, class Period,
+                  class = typename enable_if<is_integral<Rep>::value &&
+                                             timecode_detail::Conversion<Period, ratio<1> >::exact>::type>
+        BasicTimeCode(const chrono::duration<Rep, Period>& d) {
+            if (d.count() < 0) {
+                throw invalid_argument("Cannot have negative time!");
+            }
+            t = timecode_detail::ConvertTicks<Period, ratio<1> >(static_cast<long long unsigned int>(d.count()));
+        }
 
         void SetHours(unsigned int hours);
         void SetMinutes(unsigned int minutes);
@@ -22,27 +86,251 @@ class TimeCode {
         unsigned int GetSeconds() const;
 
         long long unsigned int GetTimeCodeAsSeconds() const { return t; };
+        long long unsigned int GetTicks() const { return t; };
+        static BasicTimeCode FromTicks(long long unsigned int ticks) { return BasicTimeCode(0, 0, ticks); };
+        chrono::duration<long long unsigned int> ToDuration() const { return chrono::duration<long long unsigned int>(t); };
+
         void GetComponents(unsigned int& hr, unsigned int& min, unsigned int& sec) const;
         static long long unsigned int ComponentsToSeconds(unsigned int hr, unsigned int min, unsigned long long int sec);
 
         string ToString() const;
 
-        TimeCode operator+(const TimeCode& other) const;
-        TimeCode operator-(const TimeCode& other) const;
-        TimeCode operator*(double a) const;
-        TimeCode operator/(double a) const;
+        BasicTimeCode operator+(const BasicTimeCode& other) const;
+        BasicTimeCode operator-(const BasicTimeCode& other) const;
+        BasicTimeCode operator*(double a) const;
+        BasicTimeCode operator/(double a) const;
+
+        // Integer factors are scaled exactly instead of going through double.
+        template <class Int>
+        typename enable_if<is_integral<Int>::value, BasicTimeCode>::type operator*(Int a) const {
+            if (a < 0) {
+                throw invalid_argument("Cannot multiply by a negative number!");
+            }
+            return Scale(static_cast<long long unsigned int>(a), 1);
+        }
+
+        template <class Int>
+        typename enable_if<is_integral<Int>::value, BasicTimeCode>::type operator/(Int a) const {
+            if (a == 0) {
+                throw invalid_argument("Cannot divide by 0!");
+            }
+            if (a < 0) {
+                throw invalid_argument("Cannot divide by a negative number!");
+            }
+            return Scale(1, static_cast<long long unsigned int>(a));
+        }
+
+        // Multiplies by the ratio num/den without losing precision.
+        BasicTimeCode Scale(long long unsigned int num, long long unsigned int den,
+                            TimeCodeRounding mode = TimeCodeRounding::TowardZero) const;
+
+        bool operator == (const BasicTimeCode& other) const;
+        bool operator != (const BasicTimeCode& other) const;
+
+        bool operator < (const BasicTimeCode& other) const;
+        bool operator <= (const BasicTimeCode& other) const;
+
+        bool operator > (const BasicTimeCode& other) const;
+        bool operator >= (const BasicTimeCode& other) const;
+
+    private:
+        long long unsigned int t = 0;
+
+};
+
+typedef BasicTimeCode<ratio<1> > TimeCode;
+
+// Sub-second time code. t counts ticks of Resolution (e.g. milliseconds).
+template <class Resolution>
+class BasicTimeCode {
+    static_assert(Resolution::num == 1 && Resolution::den > 1,
+                  "BasicTimeCode resolution must be a fraction of a second");
+
+    public:
+        typedef Resolution resolution;
+        typedef chrono::duration<long long unsigned int, Resolution> duration;
+
+        static long long unsigned int TicksPerSecond() { return Resolution::den; }
 
-        bool operator == (const TimeCode& other) const;
-        bool operator != (const TimeCode& other) const;
+        BasicTimeCode(unsigned int hr = 0, unsigned int min = 0, long long unsigned int sec = 0,
+                      long long unsigned int subsec = 0) {
+            t = AddSeconds(TimeCode(hr, min, sec).GetTicks());
+            if (subsec > numeric_limits<long long unsigned int>::max() - t) {
+                throw overflow_error("TimeCode conversion overflows!");
+            }
+            t += subsec;
+        }
 
-        bool operator < (const TimeCode& other) const;
-        bool operator <= (const TimeCode& other) const;
+        // Implicit only when no precision is lost (e.g. TimeCode -> MilliTimeCode).
+        // Use timecode_cast for the truncating direction.
+        template <class From,
+                  class = typename enable_if<timecode_detail::Conversion<From, Resolution>::exact>::type>
+        BasicTimeCode(const BasicTimeCode<From>& other)
+            : t(timecode_detail::ConvertTicks<From, Resolution>(other.GetTicks())) {}
 
-        bool operator > (const TimeCode& other) const;
-        bool operator >= (const TimeCode& other) const;
+        // Same rule for chrono durations: integral Rep, no finer Period.
+        template <class Rep, class Period,
+                  class = typename enable_if<is_integral<Rep>::value &&
+                                             timecode_detail::Conversion<Period, Resolution>::exact>::type>
+        BasicTimeCode(const chrono::duration<Rep, Period>& d) {
+            if (d.count() < 0) {
+                throw invalid_argument("Cannot have negative time!");
+            }
+            t = timecode_detail::ConvertTicks<Period, Resolution>(static_cast<long long unsigned int>(d.count()));
+        }
+
+        void reset() { t = 0; }
+
+        unsigned int GetHours() const { return t / TicksPerSecond() / 3600; }
+        unsigned int GetMinutes() const { return (t / TicksPerSecond() % 3600) / 60; }
+        unsigned int GetSeconds() const { return t / TicksPerSecond() % 60; }
+        long long unsigned int GetSubseconds() const { return t % TicksPerSecond(); }
+
+        // Whole seconds, truncating any sub-second part.
+        long long unsigned int GetTimeCodeAsSeconds() const { return t / TicksPerSecond(); }
+        long long unsigned int GetTicks() const { return t; }
+        static BasicTimeCode FromTicks(long long unsigned int ticks) {
+            BasicTimeCode tc;
+            tc.t = ticks;
+            return tc;
+        }
+        duration ToDuration() const { return duration(t); }
+
+        void GetComponents(unsigned int& hr, unsigned int& min, unsigned int& sec,
+                           long long unsigned int& subsec) const {
+            TimeCode(0, 0, GetTimeCodeAsSeconds()).GetComponents(hr, min, sec);
+            subsec = GetSubseconds();
+        }
+
+        // "h:m:s.fff", with as many fraction digits as the resolution needs.
+        string ToString() const {
+            int digits = 0;
+            for (long long unsigned int d = TicksPerSecond() - 1; d > 0; d /= 10) {
+                digits++;
+            }
+            ostringstream oss;
+            oss << TimeCode(0, 0, GetTimeCodeAsSeconds()).ToString() << "."
+                << setw(digits) << setfill('0') << GetSubseconds();
+            return oss.str();
+        }
+
+        BasicTimeCode operator+(const BasicTimeCode& other) const {
+            return FromTicks(t + other.t);
+        }
+
+        BasicTimeCode operator-(const BasicTimeCode& other) const {
+            if (t < other.t) {
+                throw invalid_argument("Cannot have negative time!");
+            }
+            return FromTicks(t - other.t);
+        }
+
+        BasicTimeCode operator*(double a) const {
+            if (a < 0) {
+                throw invalid_argument("Cannot multiply by a negative number!");
+            }
+            return FromTicks(static_cast<long long unsigned int>(t * a));
+        }
+
+        BasicTimeCode operator/(double a) const {
+            if (a == 0) {
+                throw invalid_argument("Cannot divide by 0!");
+            }
+            if (a < 0) {
+                throw invalid_argument("Cannot divide by a negative number!");
+            }
+            return FromTicks(static_cast<long long unsigned int>(t / a));
+        }
+
+        template <class Int>
+        typename enable_if<is_integral<Int>::value, BasicTimeCode>::type operator*(Int a) const {
+            if (a < 0) {
+                throw invalid_argument("Cannot multiply by a negative number!");
+            }
+            return Scale(static_cast<long long unsigned int>(a), 1);
+        }
+
+        template <class Int>
+        typename enable_if<is_integral<Int>::value, BasicTimeCode>::type operator/(Int a) const {
+            if (a == 0) {
+                throw invalid_argument("Cannot divide by 0!");
+            }
+            if (a < 0) {
+                throw invalid_argument("Cannot divide by a negative number!");
+            }
+            return Scale(1, static_cast<long long unsigned int>(a));
+        }
+
+        BasicTimeCode Scale(long long unsigned int num, long long unsigned int den,
+                            TimeCodeRounding mode = TimeCodeRounding::TowardZero) const {
+            return FromTicks(timecode_detail::ScaleTicks(t, num, den, mode));
+        }
+
+        bool operator == (const BasicTimeCode& other) const { return t == other.t; }
+        bool operator != (const BasicTimeCode& other) const { return t != other.t; }
+
+        bool operator < (const BasicTimeCode& other) const { return t < other.t; }
+        bool operator <= (const BasicTimeCode& other) const { return t <= other.t; }
+
+        bool operator > (const BasicTimeCode& other) const { return t > other.t; }
+        bool operator >= (const BasicTimeCode& other) const { return t >= other.t; }
 
     private:
+        static long long unsigned int AddSeconds(long long unsigned int sec) {
+            if (sec > numeric_limits<long long unsigned int>::max() / TicksPerSecond()) {
+                throw overflow_error("TimeCode conversion overflows!");
+            }
+            return sec * TicksPerSecond();
+        }
+
         long long unsigned int t = 0;
 
 };
-#endif
\ No newline at end of file
+
+typedef BasicTimeCode<milli> MilliTimeCode;
+typedef BasicTimeCode<micro> MicroTimeCode;
+typedef BasicTimeCode<nano> NanoTimeCode;
+
+// Explicit, truncating conversion between resolutions (like duration_cast).
+template <class To, class From>
+To timecode_cast(const BasicTimeCode<From>& from) {
+    return To::FromTicks(timecode_detail::ConvertTicks<From, typename To::resolution>(from.GetTicks()));
+}
+
+namespace timecode_detail {
+    // Finest resolution both R1 and R2 convert to exactly (as for durations).
+    template <class R1, class R2>
+    struct CommonResolution {
+        typedef typename common_type<chrono::duration<long long unsigned int, R1>,
+                                     chrono::duration<long long unsigned int, R2> >::type::period type;
+    };
+
+    // -1, 0 or 1 as a is shorter than, equal to or longer than b.
+    template <class R1, class R2>
+    int Compare(const BasicTimeCode<R1>& a, const BasicTimeCode<R2>& b) {
+        typedef typename CommonResolution<R1, R2>::type Common;
+        long long unsigned int x = ConvertTicks<R1, Common>(a.GetTicks());
+        long long unsigned int y = ConvertTicks<R2, Common>(b.GetTicks());
+        return x < y ? -1 : (x > y ? 1 : 0);
+    }
+}
+
+// Comparisons across resolutions, in either order. Both sides are converted
+// to their common resolution, so nothing is truncated.
+#define TIMECODE_MIXED_COMPARISON(op) \
+    template <class R1, class R2> \
+    typename enable_if<!is_same<R1, R2>::value, bool>::type \
+    operator op (const BasicTimeCode<R1>& a, const BasicTimeCode<R2>& b) { \
+        return timecode_detail::Compare(a, b) op 0; \
+    }
+
+TIMECODE_MIXED_COMPARISON(==)
+TIMECODE_MIXED_COMPARISON(!=)
+TIMECODE_MIXED_COMPARISON(<)
+TIMECODE_MIXED_COMPARISON(<=)
+TIMECODE_MIXED_COMPARISON(>)
+TIMECODE_MIXED_COMPARISON(>=)
+
+#undef TIMECODE_MIXED_COMPARISON
+
+#endif
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <assert.h>
 #include "TimeCode.h"
+#include "TimeOfDay.h"
 
 using namespace std;
 
@@ -394,6 +395,199 @@ void TestAverage(){
 	
 	cout << "PASSED!" << endl << endl;
 }
+
+void TestBasicTimeCode(){
+	cout << "Testing BasicTimeCode" << endl;
+	
+	// test 1, components plus sub-second ticks
+	MilliTimeCode ms = MilliTimeCode(1, 2, 3, 45);
+	assert(ms.GetTicks() == 3723045);
+	assert(ms.GetTimeCodeAsSeconds() == 3723);
+	assert(ms.GetSubseconds() == 45);
+	assert(ms.ToString() == "1:2:3.045");
+	
+	// test 2, lossless implicit conversion from seconds
+	MicroTimeCode us = TimeCode(0, 1, 30);
+	assert(us.GetTicks() == 90000000);
+	MilliTimeCode ms2 = ms + TimeCode(0, 0, 1);
+	assert(ms2.ToString() == "1:2:4.045");
+	
+	// test 3, truncating cast back to coarser resolutions
+	assert(timecode_cast<TimeCode>(ms) == TimeCode(1, 2, 3));
+	assert(timecode_cast<MilliTimeCode>(NanoTimeCode::FromTicks(1999999)).GetTicks() == 1);
+	
+	// test 4, chrono interop
+	MilliTimeCode ms3 = chrono::seconds(2);
+	assert(ms3.GetTicks() == 2000);
+	assert(ms3.ToDuration() == chrono::milliseconds(2000));
+	static_assert(!is_convertible<chrono::duration<double>, TimeCode>::value,
+	              "floating-point durations must not convert implicitly");
+	static_assert(!is_convertible<chrono::duration<double, milli>, MilliTimeCode>::value,
+	              "floating-point durations must not convert implicitly");
+	static_assert(!is_convertible<chrono::milliseconds, TimeCode>::value,
+	              "finer durations must not convert implicitly");
+	TimeCode tc = chrono::minutes(3);
+	assert(tc.ToString() == "0:3:0");
+	assert(tc.ToDuration() == chrono::seconds(180));
+	try{
+		MilliTimeCode ms4 = chrono::milliseconds(-1);
+		cout << "ms4:" << ms4.ToString() << endl;
+		assert(false);
+	} catch (const invalid_argument& e){
+	}
+	
+	// test 5, overflow when widening
+	try{
+		NanoTimeCode ns = TimeCode(0, 0, 20000000000ULL);
+		cout << "ns:" << ns.ToString() << endl;
+		assert(false);
+	} catch (const overflow_error& e){
+	}
+	
+	// test 6, scaling keeps sub-second precision
+	MilliTimeCode ms5 = MilliTimeCode(0, 0, 1, 1) / 2.0;
+	assert(ms5.ToString() == "0:0:0.500");
+	assert(MilliTimeCode(0, 0, 0, 250) < MilliTimeCode(0, 0, 0, 251));
+	
+	// test 7, sub-second ticks that overflow the total
+	try{
+		MilliTimeCode ms6 = MilliTimeCode(0, 0, 1, numeric_limits<long long unsigned int>::max() - 999);
+		cout << "ms6:" << ms6.ToString() << endl;
+		assert(false);
+	} catch (const overflow_error& e){
+	}
+	assert(MilliTimeCode(0, 0, 1, numeric_limits<long long unsigned int>::max() - 1000).GetTicks() ==
+	       numeric_limits<long long unsigned int>::max());
+	
+	// test 8, comparisons across resolutions work with either side first
+	assert(TimeCode(0, 0, 1) == MilliTimeCode(0, 0, 0, 1000));
+	assert(MilliTimeCode(0, 0, 0, 1000) == TimeCode(0, 0, 1));
+	assert(TimeCode(0, 0, 1) < MilliTimeCode(0, 0, 1, 1));
+	assert(MilliTimeCode(0, 0, 1, 1) > TimeCode(0, 0, 1));
+	assert(TimeCode(0, 0, 2) >= MicroTimeCode(0, 0, 1, 999999));
+	assert(NanoTimeCode(0, 0, 0, 1) != MilliTimeCode());
+	assert(MilliTimeCode(0, 0, 0, 1) <= MicroTimeCode(0, 0, 0, 1000));
+	assert((BasicTimeCode<ratio<1, 1024> >::FromTicks(512) == MilliTimeCode(0, 0, 0, 500)));  // Compared in 1/128000 s
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+void TestScale(){
+	cout << "Testing Scale" << endl;
+	
+	// test 1, integer factors stay exact above 2^53
+	TimeCode big = TimeCode(0, 0, (1ULL << 60) + 1);
+	assert((big * 3).GetTimeCodeAsSeconds() == 3 * ((1ULL << 60) + 1));
+	assert(((big * 7) / 7) == big);
+	assert((TimeCode(0, 0, (1ULL << 60) + 7) / 7).GetTimeCodeAsSeconds() == ((1ULL << 60) + 7) / 7);
+	
+	// test 2, rational factors and rounding modes
+	TimeCode tc = TimeCode(0, 0, 10);
+	assert(tc.Scale(2, 3).GetTimeCodeAsSeconds() == 6);
+	assert(tc.Scale(2, 3, TimeCodeRounding::Nearest).GetTimeCodeAsSeconds() == 7);
+	assert(tc.Scale(1, 4, TimeCodeRounding::TowardZero).GetTimeCodeAsSeconds() == 2);
+	assert(tc.Scale(1, 4, TimeCodeRounding::Nearest).GetTimeCodeAsSeconds() == 3);
+	assert(tc.Scale(1, 3, TimeCodeRounding::Nearest).GetTimeCodeAsSeconds() == 3);
+	assert(tc.Scale(1, 3, TimeCodeRounding::Up).GetTimeCodeAsSeconds() == 4);
+	assert(tc.Scale(5, 5, TimeCodeRounding::Up) == tc);
+	
+	// test 3, overflow is reported instead of wrapping
+	try{
+		TimeCode tc2 = TimeCode(0, 0, 1ULL << 62) * 4;
+		cout << "tc2:" << tc2.ToString() << endl;
+		assert(false);
+	} catch (const overflow_error& e){
+	}
+	
+	// test 4, bad divisors
+	try{
+		TimeCode tc3 = tc.Scale(1, 0);
+		cout << "tc3:" << tc3.ToString() << endl;
+		assert(false);
+	} catch (const invalid_argument& e){
+	}
+	try{
+		TimeCode tc4 = tc / 0;
+		cout << "tc4:" << tc4.ToString() << endl;
+		assert(false);
+	} catch (const invalid_argument& e){
+	}
+	
+	// test 5, sub-second resolutions share the same path
+	MilliTimeCode ms = MilliTimeCode(0, 0, 1, 1) / 2;
+	assert(ms.ToString() == "0:0:0.500");
+	assert(MilliTimeCode(0, 0, 1, 1).Scale(1, 2, TimeCodeRounding::Nearest).ToString() == "0:0:0.501");
+	
+	cout << "PASSED!" << endl << endl;
+}
+
+void TestTimeOfDay(){
+	cout << "Testing TimeOfDay" << endl;
+	
+	// test 1, half the size of a TimeCode
+	assert(sizeof(TimeOfDay) * 2 <= sizeof(TimeCode));
+	
+	// test 2, same component API and rollover as TimeCode
+	TimeOfDay tod = TimeOfDay(3, 71, 3801);
+	assert(tod.ToString() == "5:14:21");
+	assert(tod.GetHours() == 5 && tod.GetMinutes() == 14 && tod.GetSeconds() == 21);
+	TimeCode tc = tod;
+	assert(tc == TimeCode(5, 14, 21));
+	assert(TimeOfDay(tc) == tod);
+	
+	// test 3, checked conversions and arithmetic stay within the day
+	try{
+		TimeOfDay tod2 = TimeOfDay(TimeCode(24, 0, 0));
+		cout << "tod2:" << tod2.ToString() << endl;
+		assert(false);
+	} catch (const out_of_range& e){
+	}
+	try{
+		TimeOfDay tod3 = TimeOfDay(23, 0, 0) + TimeOfDay(1, 0, 0);
+		cout << "tod3:" << tod3.ToString() << endl;
+		assert(false);
+	} catch (const out_of_range& e){
+	}
+	assert(TimeOfDay(23, 0, 0) - TimeOfDay(1, 30, 0) == TimeOfDay(21, 30, 0));
+	assert(TimeOfDay(6, 0, 0) * 2 == TimeOfDay(12, 0, 0));
+	assert(TimeOfDay(6, 0, 0) / 4 == TimeOfDay(1, 30, 0));
+	assert(TimeOfDay(1, 0, 0) < TimeOfDay(1, 0, 1));
+	
+	// test 4, packed array round trip, including fields that straddle words
+	PackedTimeOfDayArray arr;
+	long long unsigned int sum = 0;
+	for (unsigned int i = 0; i < 1000; i++) {
+		TimeOfDay v = TimeOfDay(0, 0, (i * 7919) % TimeOfDay::SecondsPerDay);
+		arr.push_back(v);
+		sum += v.GetTimeCodeAsSeconds();
+	}
+	assert(arr.size() == 1000);
+	for (unsigned int i = 0; i < 1000; i++) {
+		assert(arr[i] == TimeOfDay(0, 0, (i * 7919) % TimeOfDay::SecondsPerDay));
+	}
+	assert(arr.SumSeconds() == sum);
+	assert(arr.MemoryBytes() * 3 <= 1000 * sizeof(TimeCode));
+	arr.set(3, TimeOfDay(23, 59, 59));
+	assert(arr[3] == TimeOfDay(23, 59, 59));
+	assert(arr[2] == TimeOfDay(0, 0, 2 * 7919));
+	assert(arr[4] == TimeOfDay(0, 0, 4 * 7919));
+	
+	// test 5, raw words round trip (how snapshots store the column)
+	PackedTimeOfDayArray copy;
+	copy.AssignWords(arr.Words().data(), arr.Words().size(), arr.size());
+	assert(copy.size() == 1000);
+	assert(copy.Words() == arr.Words());
+	assert(copy[3] == TimeOfDay(23, 59, 59));
+	assert(copy.SumSeconds() == arr.SumSeconds());
+	try{
+		copy.AssignWords(arr.Words().data(), arr.Words().size() - 1, arr.size());
+		assert(false);
+	} catch (const invalid_argument& e){
+	}
+	assert(copy.size() == 1000);  // Unchanged after the rejected assign
+	
+	cout << "PASSED!" << endl << endl;
+}
 	
 	
 int main(){
@@ -427,6 +621,10 @@ int main(){
 	
 	TestAverage();
 	
+	TestBasicTimeCode();
+	TestScale();
+	TestTimeOfDay();
+	
 	cout << "PASSED ALL TESTS!!!" << endl;
 	return 0;
 }
\ No newline at end of file
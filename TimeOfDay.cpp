@@ -0,0 +1,105 @@
+#include "TimeOfDay.h"
+#include <stdexcept> // For out_of_range / invalid_argument
+
+using namespace std;
+
+static const uint64_t kMask = (uint64_t(1) << TimeOfDay::Bits) - 1;
+
+// Constructor: Carries like TimeCode, but the total must stay within one day.
+TimeOfDay::TimeOfDay(unsigned int hr, unsigned int min, unsigned int sec)
+    : TimeOfDay(TimeCode(hr, min, sec)) {
+}
+
+// Checked narrowing from TimeCode.
+TimeOfDay::TimeOfDay(const TimeCode& tc) {
+    if (tc.GetTimeCodeAsSeconds() >= SecondsPerDay) {
+        throw out_of_range("Time of day must be less than 24 hours!");
+    }
+    t = static_cast<uint32_t>(tc.GetTimeCodeAsSeconds());
+}
+
+// Extracts hours, minutes, and seconds.
+void TimeOfDay::GetComponents(unsigned int& hr, unsigned int& min, unsigned int& sec) const {
+    hr = GetHours();
+    min = GetMinutes();
+    sec = GetSeconds();
+}
+
+// Same "h:m:s" format as TimeCode.
+string TimeOfDay::ToString() const {
+    return TimeCode(*this).ToString();
+}
+
+TimeOfDay TimeOfDay::operator+(const TimeOfDay& other) const {
+    return TimeOfDay(TimeCode(*this) + TimeCode(other));
+}
+
+TimeOfDay TimeOfDay::operator-(const TimeOfDay& other) const {
+    return TimeOfDay(TimeCode(*this) - TimeCode(other));
+}
+
+// Reads the Bits-wide field at index i, which may straddle two words.
+uint32_t PackedTimeOfDayArray::Get(size_t i) const {
+    size_t bit = i * TimeOfDay::Bits;
+    size_t word = bit / 64;
+    unsigned int shift = bit % 64;
+    uint64_t value = words[word] >> shift;
+    if (shift + TimeOfDay::Bits > 64) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return static_cast<uint32_t>(value & kMask);
+}
+
+// Writes the Bits-wide field at index i.
+void PackedTimeOfDayArray::Put(size_t i, uint32_t value) {
+    size_t bit = i * TimeOfDay::Bits;
+    size_t word = bit / 64;
+    unsigned int shift = bit % 64;
+    words[word] = (words[word] & ~(kMask << shift)) | (uint64_t(value) << shift);
+    if (shift + TimeOfDay::Bits > 64) {
+        unsigned int spill = 64 - shift;
+        words[word + 1] = (words[word + 1] & ~(kMask >> spill)) | (uint64_t(value) >> spill);
+    }
+}
+
+void PackedTimeOfDayArray::push_back(const TimeOfDay& tod) {
+    words.resize(WordsFor(count + 1));
+    Put(count, static_cast<uint32_t>(tod.GetTimeCodeAsSeconds()));
+    count++;
+}
+
+TimeOfDay PackedTimeOfDayArray::operator[](size_t i) const {
+    if (i >= count) {
+        throw out_of_range("PackedTimeOfDayArray index out of range!");
+    }
+    return TimeOfDay(0, 0, Get(i));
+}
+
+void PackedTimeOfDayArray::set(size_t i, const TimeOfDay& tod) {
+    if (i >= count) {
+        throw out_of_range("PackedTimeOfDayArray index out of range!");
+    }
+    Put(i, static_cast<uint32_t>(tod.GetTimeCodeAsSeconds()));
+}
+
+void PackedTimeOfDayArray::AssignWords(const uint64_t* packed, size_t wordCount, size_t n) {
+    if (wordCount != WordsFor(n)) {
+        throw invalid_argument("Packed word count does not match entry count!");
+    }
+    words.assign(packed, packed + wordCount);
+    count = n;
+}
+
+void PackedTimeOfDayArray::clear() {
+    words.clear();
+    count = 0;
+}
+
+// Streams the words once, decoding fields in order.
+long long unsigned int PackedTimeOfDayArray::SumSeconds() const {
+    long long unsigned int sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += Get(i);
+    }
+    return sum;
+}
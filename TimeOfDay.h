@@ -0,0 +1,102 @@
+#ifndef TIMEOFDAY_H
+#define TIMEOFDAY_H
+
+#include <cstdint>     // For uint32_t / uint64_t storage
+#include <vector>      // For the packed array's backing words
+#include <type_traits> // For the integral scaling overloads
+#include "TimeCode.h"
+
+using namespace std;
+
+// A time within one day (0:0:0 to 23:59:59) stored in 32 bits instead of
+// TimeCode's 64. Conversions from TimeCode are checked and throw
+// out_of_range; conversions to TimeCode are implicit.
+class TimeOfDay {
+    public:
+        static const unsigned int SecondsPerDay = 86400;
+        static const unsigned int Bits = 17;  // 86399 < 2^17
+
+        TimeOfDay(unsigned int hr = 0, unsigned int min = 0, unsigned int sec = 0);
+        explicit TimeOfDay(const TimeCode& tc);
+
+        operator TimeCode() const { return TimeCode(0, 0, t); };
+
+        void reset() { t = 0; };
+
+        unsigned int GetHours() const { return t / 3600; };
+        unsigned int GetMinutes() const { return (t % 3600) / 60; };
+        unsigned int GetSeconds() const { return t % 60; };
+
+        long long unsigned int GetTimeCodeAsSeconds() const { return t; };
+        void GetComponents(unsigned int& hr, unsigned int& min, unsigned int& sec) const;
+
+        string ToString() const;
+
+        // Results must still fall within the day, otherwise out_of_range.
+        TimeOfDay operator+(const TimeOfDay& other) const;
+        TimeOfDay operator-(const TimeOfDay& other) const;
+        TimeOfDay operator*(double a) const { return TimeOfDay(TimeCode(*this) * a); };
+        TimeOfDay operator/(double a) const { return TimeOfDay(TimeCode(*this) / a); };
+
+        template <class Int>
+        typename enable_if<is_integral<Int>::value, TimeOfDay>::type operator*(Int a) const {
+            return TimeOfDay(TimeCode(*this) * a);
+        }
+
+        template <class Int>
+        typename enable_if<is_integral<Int>::value, TimeOfDay>::type operator/(Int a) const {
+            return TimeOfDay(TimeCode(*this) / a);
+        }
+
+        bool operator == (const TimeOfDay& other) const { return t == other.t; };
+        bool operator != (const TimeOfDay& other) const { return t != other.t; };
+
+        bool operator < (const TimeOfDay& other) const { return t < other.t; };
+        bool operator <= (const TimeOfDay& other) const { return t <= other.t; };
+
+        bool operator > (const TimeOfDay& other) const { return t > other.t; };
+        bool operator >= (const TimeOfDay& other) const { return t >= other.t; };
+
+    private:
+        uint32_t t = 0;
+
+};
+
+typedef TimeOfDay TimeCode32;
+
+// Dense storage for many TimeOfDay values: each one takes TimeOfDay::Bits
+// bits packed back to back in 64-bit words (~2 bytes per entry versus 8 for
+// a vector<TimeCode>).
+class PackedTimeOfDayArray {
+    public:
+        void push_back(const TimeOfDay& tod);
+        TimeOfDay operator[](size_t i) const;
+        void set(size_t i, const TimeOfDay& tod);
+
+        size_t size() const { return count; };
+        bool empty() const { return count == 0; };
+        void clear();
+        void reserve(size_t n) { words.reserve(WordsFor(n)); };
+
+        // Sum of all entries in seconds, for averaging without unpacking
+        // into TimeCode objects.
+        long long unsigned int SumSeconds() const;
+
+        // Bytes held by the packed words.
+        size_t MemoryBytes() const { return words.size() * sizeof(uint64_t); };
+
+        // Raw packed words, for writing and reloading the array in bulk.
+        const vector<uint64_t>& Words() const { return words; };
+        void AssignWords(const uint64_t* packed, size_t wordCount, size_t n);
+
+    private:
+        static size_t WordsFor(size_t n) { return (n * TimeOfDay::Bits + 63) / 64; };
+        uint32_t Get(size_t i) const;
+        void Put(size_t i, uint32_t value);
+
+        vector<uint64_t> words;
+        size_t count = 0;
+
+};
+
+#endif
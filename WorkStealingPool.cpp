@@ -0,0 +1,110 @@
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+// Which pool (if any) the current thread works for, and its index there.
+static thread_local const WorkStealingPool* current_pool = nullptr;
+static thread_local int current_index = -1;
+
+WorkStealingPool::WorkStealingPool(unsigned int threads) {
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    for (unsigned int i = 0; i < threads; i++) {
+        workers.emplace_back(new Worker);
+    }
+    for (unsigned int i = 0; i < threads; i++) {
+        this->threads.emplace_back(&WorkStealingPool::Run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    Wait();
+    {
+        lock_guard<mutex> lock(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+int WorkStealingPool::CurrentWorker() const {
+    return current_pool == this ? current_index : -1;
+}
+
+void WorkStealingPool::Submit(function<void()> task) {
+    pending++;
+    // Counted before the push, so a thief's decrement can never run first
+    // and wrap the counter; a worker that wakes early just retries TakeTask
+    queued++;
+    int self = CurrentWorker();
+    unsigned int index = self >= 0 ? static_cast<unsigned int>(self) : nextQueue++ % workers.size();
+    {
+        lock_guard<mutex> lock(workers[index]->lock);
+        workers[index]->tasks.push_back(move(task));
+    }
+    // Notified under sleepLock, so a worker either saw the count in its wait
+    // predicate or is already waiting
+    lock_guard<mutex> lock(sleepLock);
+    wake.notify_one();
+}
+
+void WorkStealingPool::Wait() {
+    unique_lock<mutex> lock(sleepLock);
+    finished.wait(lock, [this] { return pending.load() == 0; });
+}
+
+// Own deque from the back, then other deques from the front.
+bool WorkStealingPool::TakeTask(unsigned int index, function<void()>& task) {
+    {
+        Worker& own = *workers[index];
+        lock_guard<mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < workers.size(); i++) {
+        Worker& victim = *workers[(index + i) % workers.size()];
+        lock_guard<mutex> lock(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::Run(unsigned int index) {
+    current_pool = this;
+    current_index = static_cast<int>(index);
+
+    while (true) {
+        function<void()> task;
+        if (TakeTask(index, task)) {
+            task();
+            tasksRun++;
+            if (--pending == 0) {
+                lock_guard<mutex> lock(sleepLock);
+                finished.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepLock);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Thread pool where every worker owns a deque of tasks. A worker runs its
+// own newest task first (good locality for tasks it just split off) and,
+// when it runs dry, steals the oldest task from another worker, so one big
+// job that was split into pieces spreads across every core.
+class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(unsigned int threads = 0);  // 0 = one per core
+        ~WorkStealingPool();
+
+        // Queues task. From a worker thread it goes on that worker's own
+        // deque; from outside the pool the deques are filled round-robin.
+        void Submit(function<void()> task);
+
+        // Blocks until every submitted task (including ones they submitted)
+        // has finished. Must not be called from a worker.
+        void Wait();
+
+        unsigned int Size() const { return static_cast<unsigned int>(workers.size()); }
+
+        // Index of the calling worker in this pool, or -1 for other threads.
+        int CurrentWorker() const;
+
+        uint64_t TasksRun() const { return tasksRun.load(); }
+        uint64_t Steals() const { return steals.load(); }
+
+    private:
+        struct Worker {
+            mutex lock;
+            deque<function<void()> > tasks;
+        };
+
+        void Run(unsigned int index);
+        bool TakeTask(unsigned int index, function<void()>& task);
+
+        vector<unique_ptr<Worker> > workers;
+        vector<thread> threads;
+
+        atomic<size_t> pending{0};   // Submitted and not yet finished
+        atomic<size_t> queued{0};    // Submitted, not yet taken
+        atomic<unsigned int> nextQueue{0};
+        atomic<bool> stopping{false};
+        atomic<uint64_t> tasksRun{0};
+        atomic<uint64_t> steals{0};
+
+        mutex sleepLock;
+        condition_variable wake;      // Signalled when work arrives or the pool stops
+        condition_variable finished;  // Signalled when pending reaches 0
+
+};
+
+#endif